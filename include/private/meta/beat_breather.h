@@ -155,12 +155,22 @@ namespace lsp
             static constexpr float  OUT_FREQ_DFL            = 20000.0f;
             static constexpr float  OUT_FREQ_STEP           = 0.002f;
 
+            static constexpr float  OVL_TIER_MIN            = 0.0f;
+            static constexpr float  OVL_TIER_MAX            = 4.0f;
+            static constexpr float  OVL_TIER_DFL            = 0.0f;
+            static constexpr float  OVL_TIER_STEP           = 1.0f;
+
             static constexpr size_t FFT_MESH_POINTS         = 640;
             static constexpr size_t CURVE_MESH_POINTS       = 256;
             static constexpr size_t BANDS_MAX               = 8;
             static constexpr size_t FFT_XOVER_RANK_MIN      = 12;
             static constexpr size_t FFT_XOVER_FREQ_MIN      = 44100;
+            static constexpr size_t FFT_XOVER_RANK_ECONOMY  = 10;       // Lowest crossover rank of the economy profile
+            static constexpr float  FFT_XOVER_ECONOMY_BINS  = 4.0f;     // Minimum FFT bins in the octave below the lowest split
+            static constexpr float  FFT_XOVER_ECONOMY_SLOPE = 6.0f;     // Filter slope (dB/oct) resolved by one FFT bin
             static constexpr size_t FFT_ANALYZER_RANK       = 13;
+            static constexpr size_t FFT_ANALYZER_RANK_MIN   = 10;
+            static constexpr size_t FFT_ANALYZER_FREQ       = 44100;    // Minimum sample rate the analyzer input is decimated to
             static constexpr size_t FFT_ANALYZER_ITEMS      = 1 << FFT_ANALYZER_RANK;
             static constexpr size_t FFT_ANALYZER_WINDOW     = dspu::windows::HANN;
             static constexpr size_t FFT_ANALYZER_RATE       = 20;
@@ -172,6 +182,36 @@ namespace lsp
             static constexpr size_t TIME_MESH_POINTS        = 320;
             static constexpr float  TIME_HISTORY_MAX        = 2.0f;     // Time history of punch detector
 
+            static constexpr float  OVL_LOAD_HIGH           = 0.5f;     // Part of the block deadline considered as overload
+            static constexpr float  OVL_LOAD_LOW            = 0.25f;    // Part of the block deadline considered as safe for recovery
+            static constexpr float  OVL_REACT_TIME          = 0.05f;    // Reactivity of the processing load estimation
+            static constexpr float  OVL_DEGRADE_TIME        = 0.2f;     // Time of sustained overload before stepping down
+            static constexpr float  OVL_RECOVER_TIME        = 2.0f;     // Time of sustained safe load before stepping up
+            static constexpr size_t OVL_CTL_DECIMATION      = 4;        // Envelope control rate decimation on overload
+            static constexpr size_t OVL_BACKOFF_MAX         = 4;        // Maximum power of 2 for the recovery time backoff
+
+            static constexpr size_t MULTIRATE_MAX           = 8;        // Maximum decimation of the envelope path of low bands
+            static constexpr float  MULTIRATE_MARGIN        = 4.0f;     // Minimum ratio between decimated sample rate and the top frequency of the band
+
+            static constexpr float  EARLY_SLOPE_STEP        = 12.0f;    // Slope (dB/oct) added by each order of early band estimate filters
+
+            enum xover_quality_t
+            {
+                XOVER_ECONOMY,              // Minimal rank satisfying the lowest split and the steepest slope
+                XOVER_STANDARD,             // Rank selected by the sample rate
+                XOVER_HIGH,                 // Doubled resolution relative to the standard rank
+
+                XOVER_QUALITY_DFL = XOVER_STANDARD
+            };
+
+            enum tab_t
+            {
+                TAB_BAND_FILTER,
+                TAB_PUNCH_DETECTOR,
+                TAB_PUNCH_FILTER,
+                TAB_BEAT_PROCESSOR
+            };
+
             enum listen_t
             {
                 LISTEN_CROSSOVER,
@@ -182,6 +222,15 @@ namespace lsp
                 LISTEN_DFL = LISTEN_BEAT
             };
 
+            enum overload_t
+            {
+                OVL_NONE,                   // Full quality processing
+                OVL_ANALYZER,               // + Spectrum analyzer disabled
+                OVL_METERS,                 // + Meters and meshes are not computed
+                OVL_ENVELOPE,               // + Envelope control rate is lowered
+                OVL_CROSSOVER               // + Crossover FFT rank is reduced
+            };
+
         } beat_breather;
 
         // Plugin type metadata
@@ -25,11 +25,13 @@
 #include <lsp-plug.in/dsp-units/ctl/Bypass.h>
 #include <lsp-plug.in/dsp-units/ctl/Counter.h>
 #include <lsp-plug.in/dsp-units/dynamics/Gate.h>
+#include <lsp-plug.in/dsp-units/filters/Filter.h>
 #include <lsp-plug.in/dsp-units/util/Analyzer.h>
 #include <lsp-plug.in/dsp-units/util/Delay.h>
 #include <lsp-plug.in/dsp-units/util/FFTCrossover.h>
 #include <lsp-plug.in/dsp-units/util/MeterGraph.h>
-#include <lsp-plug.in/dsp-units/util/Sidechain.h>
+#include <lsp-plug.in/dsp-units/util/SpectralProcessor.h>
+#include <lsp-plug.in/ipc/ITask.h>
 #include <lsp-plug.in/plug-fw/core/IDBuffer.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 
@@ -55,12 +57,54 @@ namespace lsp
                     BAND_BP         // + Beat processor
                 };
 
+                enum engine_t
+                {
+                    ENGINE_CROSSOVER,   // Each band is synthesized by the crossover and processed in time domain
+                    ENGINE_SPECTRAL,    // Band gains are computed from band energies and applied to the spectrum of the channel
+                    ENGINE_STATIC       // Only band filters are active: the combined static response is applied to the spectrum
+                };
+
                 enum sync_t
                 {
                     SYNC_BAND_FILTER    = 1 << 0,       // Band curve
                     SYNC_PEAK_FILTER    = 1 << 1,       // Peak filter curve
                     SYNC_BEAT_PROC      = 1 << 2,       // Peak processor curve
-                    SYNC_ALL            = SYNC_BAND_FILTER | SYNC_PEAK_FILTER | SYNC_BEAT_PROC
+                    SYNC_PEAK_CURVE     = 1 << 3,       // Peak filter curve needs to be computed
+                    SYNC_BEAT_CURVE     = 1 << 4,       // Peak processor curve needs to be computed
+                    SYNC_ALL            = SYNC_BAND_FILTER | SYNC_PEAK_FILTER | SYNC_BEAT_PROC | SYNC_PEAK_CURVE | SYNC_BEAT_CURVE
+                };
+
+                class AnalyzerTask: public ipc::ITask
+                {
+                    private:
+                        beat_breather      *pCore;
+
+                    public:
+                        explicit AnalyzerTask(beat_breather *core);
+                        AnalyzerTask(const AnalyzerTask &) = delete;
+                        AnalyzerTask(AnalyzerTask &&) = delete;
+                        virtual ~AnalyzerTask() override;
+
+                        AnalyzerTask & operator = (const AnalyzerTask &) = delete;
+                        AnalyzerTask & operator = (AnalyzerTask &&) = delete;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
+                enum bank_lanes_t
+                {
+                    GATE_LANES_MIN      = 4,                                        // Minimum number of lanes of the gate bank
+                    GATE_LANES_MAX      = meta::beat_breather::BANDS_MAX * 2,       // Maximum number of lanes of the gate bank
+                    RMS_LANES_MAX       = meta::beat_breather::BANDS_MAX * 2,       // Maximum number of lanes of the RMS bank
+                    CTL_GROUPS          = 4                                         // Number of envelope control rates: 1, 2, 4 and 8
+                };
+
+                enum halfband_taps_t
+                {
+                    HALFBAND_ODD        = 32,                                       // Number of non-zero odd coefficients on each side of the center
+                    HALFBAND_TAPS       = HALFBAND_ODD * 4 - 1,                     // Number of taps of the half-band filter
+                    HALFBAND_STAGES     = 4                                         // Maximum number of decimation stages of the analyzer input
                 };
 
                 typedef struct split_t
@@ -73,26 +117,37 @@ namespace lsp
                     plug::IPort        *pFrequency;     // Split frequency
                 } split_t;
 
-                typedef struct band_t
+                typedef struct ring_t
                 {
-                    dspu::Delay         sDelay;         // Delay compensation for the whole band
-                    dspu::Sidechain     sPdLong;        // Peak detector long RMS estimation
-                    dspu::Sidechain     sPdShort;       // Peak detector short RMS estimation
-                    dspu::Delay         sPdDelay;       // Peak detector delay for short RMS estimation
-                    dspu::MeterGraph    sPdMeter;       // Meter graph
-                    dspu::Gate          sPf;            // Punch filter
-                    dspu::Delay         sPfDelay;       // Delay for lookahead of punch filter
-                    dspu::Gate          sBp;            // Beat processor
-                    dspu::Delay         sBpScDelay;     // Beat processor sidechain delay
-                    dspu::Delay         sBpDelay;       // Beat processor delay
+                    float              *vData;          // Ring buffer data
+                    size_t              nCapacity;      // Capacity of the ring buffer
+                    size_t              nHead;          // Write position
+                    size_t              nRemapHead;     // Write position at the last change of the sample rate
+                    size_t              nRemapLength;   // Number of samples before the change read at the old rate, 0 if none
+                    size_t              nRemapPushed;   // Number of samples written since the change of the sample rate
+                    size_t              nRemapFrom;     // Old decimation of the sample rate
+                    size_t              nRemapTo;       // New decimation of the sample rate
+                } ring_t;
 
-                    band_mode_t         nOldMode;       // Old band mode
+                typedef struct band_t
+                {
                     band_mode_t         nMode;          // Band mode
+                    size_t              nCompDelay;     // Latency compensation tap of the band signal
+                    size_t              nBpDelay;       // Beat processor delay, added to the compensation tap for the output
+                    size_t              nPfDelay;       // Lookahead delay of punch filter
+                    size_t              nPdDelay;       // Delay of the short-time RMS estimation
+                    size_t              nBpScDelay;     // Delay of the beat processor sidechain
+                    size_t              nOutDelay;      // Output tap of the band signal
+                    size_t              nEarlyDelay;    // Delay of the early band estimate aligning the detection with the output tap
+                    size_t              nEarlyGd;       // Group delay of the early band estimate at the center of the band
                     float               fGain;          // Band gain
+                    float               fMute;          // Current gain of the mute ramp
+                    bool                bSilent;        // The band is not audible and fades out to become idle
+                    bool                bIdle;          // The faded out band is excluded from the processing
+                    size_t              nWarmup;        // Samples to process after the wake of the band before it fades in
                     float               fInLevel;       // Input level measured
                     float               fOutLevel;      // Output level measured
                     float               fReduction;     // Band reduction
-                    size_t              nSync;          // Synchronize curve flags
                     float               fPdMakeup;      // Peak detector makeup gain
                     float               fPdLevel;       // Peak detector level
                     float               fPfInGain;      // Peak filter input gain
@@ -102,11 +157,44 @@ namespace lsp
                     float               fBpInGain;      // Beat processor input gain
                     float               fBpOutGain;     // Beat processor output gain
                     float               fBpReduction;   // Beat processor reduction value
+                    float               fPdHold;        // Last value of peak detector control signal
+                    float               fPfHold;        // Last value of peak filter control signal
+                    float               fBpHold;        // Last value of beat processor control signal
+                    bool                bBpSteady;      // Beat processor VCA is constant for the whole block
+                    float               fBpSteady;      // Constant beat processor VCA with makeup gain
+                    size_t              nCtlRate;       // Decimation of the envelope control rate of the band
+                    size_t              nCtlGroup;      // Group of batched envelope processors matching the control rate
+                    float               fCtlTop;        // Upper frequency of the band limiting the decimation of the control rate
+                    float               fSpcLong;       // Long-time energy of the band in spectral mode
+                    float               fSpcShort;      // Short-time energy of the band in spectral mode
+                    float               fSpcPfEnv;      // Punch filter envelope in spectral mode
+                    float               fSpcBpEnv;      // Beat processor envelope in spectral mode
+                    float               fSpcLongTau;    // Per-frame coefficient of the long-time energy
+                    float               fSpcShortTau;   // Per-frame coefficient of the short-time energy
+                    float               fSpcPfAttack;   // Per-frame attack coefficient of the punch filter
+                    float               fSpcPfRelease;  // Per-frame release coefficient of the punch filter
+                    float               fSpcBpAttack;   // Per-frame attack coefficient of the beat processor
+                    float               fSpcBpRelease;  // Per-frame release coefficient of the beat processor
+                    float               fSpcBias;       // Short-time energy bias
 
                     float              *vInData;        // Original band data after crossover
                     float              *vPdData;        // Peak detector data
                     float              *vPfData;        // Output of Peak Filter
                     float              *vBpData;        // Output of Beat Processor
+
+                    ring_t              sRing;          // Multi-tap delay ring of the band signal
+                    ring_t              sPfRing;        // Delay ring for lookahead of punch filter
+                    dspu::Filter        sEarlyHpf;      // Hi-pass filter of the early band estimate
+                    dspu::Filter        sEarlyLpf;      // Lo-pass filter of the early band estimate
+                    ring_t              sPdRing;        // Delay ring of the short-time RMS estimation
+                    ring_t              sBpScRing;      // Delay ring of the beat processor sidechain
+                    dspu::Gate          sPf;            // Punch filter
+                    dspu::Gate          sBp;            // Beat processor
+                    dspu::MeterGraph    sPdMeter;       // Meter graph
+
+                    band_mode_t         nOldMode;       // Old band mode
+                    band_mode_t         nMixMode;       // Last audible band mode, mixed while the band fades out after mute
+                    size_t              nSync;          // Synchronize curve flags
                     float              *vFreqChart;     // Frequency chart
                     float              *vPfMesh;        // Peak filter mesh
                     float              *vBpMesh;        // Beat processor mesh
@@ -155,15 +243,11 @@ namespace lsp
 
                 typedef struct channel_t
                 {
-                    dspu::Bypass        sBypass;        // Bypass
-                    dspu::FFTCrossover  sCrossover;     // FFT crossover
-                    dspu::Delay         sDelay;         // Delay for channel signal
-                    dspu::Delay         sDryDelay;      // Delay compensation for the dry (unprocessed) signal
-
-                    band_t              vBands[meta::beat_breather::BANDS_MAX];     // Bands
-
-                    size_t              nAnIn;          // Analyzer input channel identifier
-                    size_t              nAnOut;         // Analyzer output channel identifier
+                    size_t              nDelay;         // Latency compensation for the dry signal
+                    size_t              nPadDelay;      // Output delay padding the latency up to the locked latency
+                    bool                bRestart;       // The engine has been restarted and its output is not valid yet
+                    size_t              nRestart;       // Number of samples processed since the restart of the engine
+                    size_t              nRestartHold;   // Padding delay before the restart, the padding still holds the valid output
                     float               fInLevel;       // Input level measured
                     float               fOutLevel;      // Output level measured
 
@@ -171,6 +255,18 @@ namespace lsp
                     float              *vOut;           // Output buffer
                     float              *vInData;        // Processed input data
                     float              *vOutData;       // Processed channel data
+
+                    ring_t              sHistory;       // History of the unprocessed input signal
+                    ring_t              sPadRing;       // Delay ring of the latency padding
+                    dspu::Bypass        sBypass;        // Bypass
+                    dspu::FFTCrossover  sCrossover;     // FFT crossover
+                    dspu::SpectralProcessor sSpectral;  // Spectral processor of the spectral gain mode
+
+                    band_t              vBands[meta::beat_breather::BANDS_MAX];     // Bands
+
+                    ssize_t             nPhaseSlot;     // Crossover phase slot in the instance registry
+                    size_t              nAnIn;          // Analyzer input channel identifier
+                    size_t              nAnOut;         // Analyzer output channel identifier
                     float              *vFreqChart;     // Frequency chart
 
                     plug::IPort        *pIn;            // Input
@@ -185,6 +281,49 @@ namespace lsp
                     plug::IPort        *pFreqMesh;      // Output transfer function mesh
                 } channel_t;
 
+                typedef struct halfband_t
+                {
+                    size_t              nHead;                              // Position of the newest sample in the delay line
+                    size_t              nPhase;                             // Phase of the decimation by 2
+                    float               vDelay[HALFBAND_TAPS * 2];          // Delay line, doubled to read the taps contiguously
+                } halfband_t;
+
+                typedef struct gate_bank_t
+                {
+                    size_t              nGates;                             // Number of active gates
+                    size_t              nLanes;                             // Number of processing lanes: 4, 8 or 16
+                    size_t              vSlot[GATE_LANES_MAX];              // Slot (channel * BANDS_MAX + band) of each lane
+                    const float        *vIn[GATE_LANES_MAX];                // Sidechain input of each lane
+                    float              *vOut[GATE_LANES_MAX];               // Envelope output of each lane
+                    float               vEnv[GATE_LANES_MAX];               // Envelope of each lane
+                    float               vTauAttack[GATE_LANES_MAX];         // Attack coefficient of each lane
+                    float               vTauRelease[GATE_LANES_MAX];        // Release coefficient of each lane
+                    float               vSlotEnv[GATE_LANES_MAX];           // Envelope of each slot, kept while the slot is inactive
+                } gate_bank_t;
+
+                typedef struct rms_bank_t
+                {
+                    size_t              nLanes;                             // Number of lanes, one per each band of each channel
+                    size_t              nCapacity;                          // Capacity of the history ring in samples
+                    size_t              nHead;                              // Write position in the history ring
+                    float              *vHistory;                           // Band-interleaved history of squared samples
+                    const float        *vIn[RMS_LANES_MAX];                 // Input of each lane, NULL for inactive lane
+                    float              *vLongOut[RMS_LANES_MAX];            // Long-time RMS output of each lane
+                    float              *vShortOut[RMS_LANES_MAX];           // Short-time RMS output of each lane
+                    size_t              vLong[RMS_LANES_MAX];               // Long-time window of each lane in samples
+                    size_t              vShort[RMS_LANES_MAX];              // Short-time window of each lane in samples
+                    float               vLongScale[RMS_LANES_MAX];          // Normalizing factor of long-time window
+                    float               vShortScale[RMS_LANES_MAX];         // Normalizing factor of short-time window, including bias
+                    double              vLongSum[RMS_LANES_MAX];            // Running sum of squares of long-time window
+                    double              vShortSum[RMS_LANES_MAX];           // Running sum of squares of short-time window
+                    size_t              vSeedHead[RMS_LANES_MAX];           // Write position at the moment of seeding
+                    size_t              vSeedLeft[RMS_LANES_MAX];           // Number of samples to process until the seed is consumed
+                    size_t              vSeedSplit[RMS_LANES_MAX];          // Length of the shorter window at the moment of seeding
+                    size_t              vSeedLength[RMS_LANES_MAX];         // Length of the longer window at the moment of seeding
+                    float               vSeedNear[RMS_LANES_MAX];           // Seed of the history covered by both windows
+                    float               vSeedFar[RMS_LANES_MAX];            // Seed of the history covered by the longer window only
+                } rms_bank_t;
+
             protected:
                 size_t              nChannels;          // Number of channels
                 channel_t          *vChannels;          // Delay channels
@@ -193,15 +332,60 @@ namespace lsp
                 float               fDryGain;           // Dry gain
                 float               fWetGain;           // Wet gain
                 float               fZoom;              // Zoom
+                float               fMuteStep;          // Per-sample step of the band mute gain ramp
+                float               fRestartStep;       // Per-sample step of the crossfade after the restart of the engine
+                size_t              nTab;               // Currently selected tab
+                size_t              nFftRank;           // FFT rank of the crossover selected by the sample rate
+                size_t              nXoverRank;         // FFT rank of the crossover selected by the settings, before the overload degradation
+                size_t              nMaxBandLatency;    // Maximum latency of the band processing
+                size_t              nLockLatency;       // Maximum possible latency at current sample rate, reported in latency lock mode
+                size_t              nCtlRate;           // Minimum decimation of the envelope control rate of all bands
+                size_t              nCtlPhase;          // Phase of the envelope control rate decimation, modulo MULTIRATE_MAX
+                bool                bOvlGuard;          // Overload guard is enabled
+                size_t              nOvlTier;           // Current overload degradation tier
+                size_t              nOvlHigh;           // Number of samples processed at overload
+                size_t              nOvlLow;            // Number of samples processed at safe load
+                size_t              nOvlBackoff;        // Backoff of the recovery from overload
+                bool                bIdleSync;          // Idle state of bands should be updated
+                bool                bUIActive;          // UI is active and shows the band meters
+                float               fOvlLoad;           // Estimated processing load
                 float              *vAnalyze[4];        // Buffers for spectrum analyzer
+                float              *vAnRing[4];         // Sample rings passing the analyzer data to the worker
+                float              *vAnData[4];         // Read positions of the sample rings for the worker
+                float               vAnFir[HALFBAND_ODD];   // Odd coefficients of the half-band filter decimating the analyzer input
+                halfband_t          vAnStages[4][HALFBAND_STAGES];  // Half-band decimation stages of each analyzer input
+                size_t              nAnDecimation;      // Decimation of the analyzer input
+                size_t              nAnStages;          // Number of half-band decimation stages of the analyzer input
+                uatomic_t           nAnHead;            // Write position of sample rings, updated by the audio thread
+                uatomic_t           nAnTail;            // Read position of sample rings, updated by the worker
+                bool                bAnSync;            // Analyzer settings have been deferred while the worker was busy
+                bool                bAnReconfig;        // Analyzer reconfiguration is pending, performed by the worker
+                bool                bAnFreqs;           // Worker has computed new analyzer frequencies to be committed
+                bool                bMultirate;         // Multirate processing of low bands
+                bool                bSpectral;          // Spectral gain mode: band gains are applied to the spectrum of the channel
+                bool                bEarly;             // Early detection: detectors are fed from IIR band estimates of the undelayed input
+                bool                bLatencyLock;       // Latency lock: the maximum possible latency is always reported
+                engine_t            nEngine;            // Processing engine selected for the current configuration
+                bool                bSpcSync;           // Band masks do not match the crossover and should be updated
+                size_t              nSpcBins;           // Number of bins of the band masks
+                float              *vSpcMask;           // Magnitude responses of bands sampled at the bins of the spectral processor
+                float              *vSpcGain;           // Per-bin gain of the spectral processor
+                float              *vSpcPower;          // Power spectrum of the frame processed by the spectral processor
+                gate_bank_t         vPfBanks[CTL_GROUPS];   // Batched envelope followers of all punch filters for each control rate
+                gate_bank_t         vBpBanks[CTL_GROUPS];   // Batched envelope followers of all beat processors for each control rate
+                rms_bank_t          vRmsBanks[CTL_GROUPS];  // Batched long-time and short-time RMS estimators for each control rate
 
                 dspu::Analyzer      sAnalyzer;          // Analyzer
+                AnalyzerTask        sAnTask;            // Analyzer worker task
+                ipc::IExecutor     *pExecutor;          // Executor service for the analyzer worker
                 dspu::Counter       sCounter;           // Sync counter
                 split_t             vSplits[meta::beat_breather::BANDS_MAX-1];
 
                 float              *vBuffer;            // Temporary buffer for processing
                 float              *vFftFreqs;          // List of FFT frequencies
                 uint32_t           *vFftIndexes;        // List of analyzer FFT indexes
+                float              *vAnFreqs;           // List of FFT frequencies computed by the analyzer worker
+                uint32_t           *vAnIndexes;         // List of analyzer FFT indexes computed by the analyzer worker
                 float              *vPdMesh;            // Peak detector mesh
                 float              *vPfMesh;            // Horizontal coordinates of peak filter curve
                 float              *vBpMesh;            // Horizontal coordinates of beat processor curve
@@ -212,31 +396,125 @@ namespace lsp
                 plug::IPort        *pWetGain;           // Wet gain
                 plug::IPort        *pDryWet;            // Dry/Wet balance
                 plug::IPort        *pOutGain;           // Output gain
+                plug::IPort        *pTabSel;            // Tab selector
                 plug::IPort        *pStereoSplit;       // Stereo split
                 plug::IPort        *pFFTReactivity;     // FFT reactivity
                 plug::IPort        *pFFTShift;          // FFT shift
                 plug::IPort        *pZoom;              // Zoom
+                plug::IPort        *pOvlGuard;          // Overload guard
+                plug::IPort        *pOvlTier;           // Overload degradation tier
+                plug::IPort        *pXoverQuality;      // Crossover quality profile
+                plug::IPort        *pMultirate;         // Multirate processing of low bands
+                plug::IPort        *pSpectral;          // Spectral gain mode
+                plug::IPort        *pEarly;             // Early detection mode
+                plug::IPort        *pLatencyLock;       // Latency lock mode
 
                 core::IDBuffer     *pIDisplay;          // Inline display buffer
 
                 uint8_t            *pData;              // Allocated data
+                uint8_t            *pRmsData;           // Allocated data for RMS history
+                uint8_t            *pRingData;          // Allocated data for delay rings
+                uint8_t            *pSpcData;           // Allocated data for band masks of the spectral gain mode
 
             protected:
                 static inline size_t        select_fft_rank(size_t sample_rate);
+                static inline bool          band_processed(band_mode_t mode);
+                static inline bool          band_mixed(band_mode_t mode);
+                static inline bool          band_active(const band_t *b);
+                static inline size_t        select_analyzer_decimation(size_t sample_rate);
+                static inline size_t        select_analyzer_rank(size_t sample_rate);
                 static void                 process_band(void *object, void *subject, size_t band, const float *data, size_t sample, size_t count);
+                static void                 process_spectrum(void *object, void *subject, float *spectrum, size_t rank);
+                static void                 apply_bin_gain(float *spectrum, const float *gain, size_t rank);
                 static void                 normalize_rms(float *dst, const float *lrms, const float *srms, float gain, size_t samples);
-                static int                  compare_splits(const void *a1, const void *a2, void *data);
+                static void                 normalize_rms_linked(float *dl, float *dr, const float *ll, const float *lr,
+                                                const float *sl, const float *sr, float gain, size_t samples);
+                static void                 sort_splits(split_t **splits, size_t count);
                 static band_mode_t          decode_band_mode(size_t mode);
+                static size_t               decimate_control(float *dst, const float *src, size_t samples, size_t phase, size_t rate);
+                static float                expand_control(float *buf, size_t samples, size_t phase, size_t rate, float hold);
+                static float                gate_tau(float sample_rate, float time);
+                static void                 init_gate_bank(gate_bank_t *gb);
+                static void                 reset_gate_bank(gate_bank_t *gb);
+                static void                 move_gate_slot(gate_bank_t *dst, const gate_bank_t *src, size_t slot);
+                static size_t               halfband_decimate(halfband_t *hb, const float *fir, float *buf, size_t samples);
+                static void                 add_gate(gate_bank_t *gb, size_t slot, const float *in, float *out, float tau_attack, float tau_release);
+                static void                 process_gate_bank(gate_bank_t *gb, float *buf, size_t samples);
+                static void                 dump_gate_bank(dspu::IStateDumper *v, const char *name, const gate_bank_t *gb);
+                static void                 init_rms_bank(rms_bank_t *rb, size_t lanes);
+                static void                 clear_rms_bank(rms_bank_t *rb);
+                static void                 seed_rms_lane(rms_bank_t *rb, size_t lane, size_t long_len, size_t short_len,
+                                                double long_mean, double short_mean);
+                static void                 fill_rms_seed(rms_bank_t *rb, size_t lane, size_t samples);
+                static void                 set_rms_lane(rms_bank_t *rb, size_t lane, const float *in, float *lrms, float *srms,
+                                                size_t long_len, size_t short_len, float short_gain);
+                static void                 move_rms_lane(rms_bank_t *dst, const rms_bank_t *src, size_t lane);
+                static void                 process_rms_bank(rms_bank_t *rb, float *buf, size_t samples);
+                static void                 dump_rms_bank(dspu::IStateDumper *v, const char *name, const rms_bank_t *rb);
+                static void                 init_ring(ring_t *r, float *data, size_t capacity);
+                static void                 ring_push(ring_t *r, const float *src, size_t count);
+                static float                ring_tail(const ring_t *r, size_t delay, float *dst, const float *vca, float gain, bool add, bool peak, size_t count);
+                static float                ring_remap_tail(const ring_t *r, size_t delay, float *dst, const float *vca, float gain, bool add, bool peak, size_t count);
+                static void                 remap_ring(ring_t *r, size_t length, size_t from, size_t to);
+                static float                fused_apply(float *dst, const float *src, const float *vca, float gain, bool add, bool peak, size_t count);
+                static void                 dump_ring(dspu::IStateDumper *v, const char *name, const ring_t *r);
+                static int32_t              curve_cache_key(float value);
+                static ssize_t              acquire_phase_slot();
+                static void                 release_phase_slot(ssize_t slot);
+                static float                phase_slot_value(size_t slot);
+                static void                 gate_curve(float *dst, dspu::Gate *gate, const float *x, size_t type,
+                                                float threshold, float zone, float reduction, float makeup);
 
             protected:
                 void                bind_inputs();
+                template <size_t CHANNELS, bool LINKED>
+                void                process_blocks(size_t samples);
+                template <size_t CHANNELS>
                 void                split_signal(size_t samples);
+                template <size_t CHANNELS>
+                void                process_spectral(size_t samples);
+                template <size_t CHANNELS, bool LINKED>
                 void                apply_peak_detector(size_t samples);
+                template <size_t CHANNELS>
                 void                apply_punch_filter(size_t samples);
+                template <size_t CHANNELS>
                 void                apply_beat_processor(size_t samples);
+                template <size_t CHANNELS>
                 void                mix_bands(size_t samples);
+                template <size_t CHANNELS>
                 void                post_process_block(size_t samples);
+                template <size_t CHANNELS>
                 void                update_pointers(size_t samples);
+                size_t              control_samples(size_t samples, size_t rate) const;
+                size_t              band_control_rate(float top) const;
+                void                update_early_filter(dspu::Filter *f, size_t type, float freq, float slope) const;
+                size_t              early_group_delay(band_t *b, float freq) const;
+                bool                update_overload(float elapsed, size_t samples);
+                void                apply_overload_tier(size_t old_tier);
+                void                configure_band_control(band_t *b, size_t slot, bool migrate);
+                void                configure_band_spectral(band_t *b, float frame_rate);
+                void                update_control_rate();
+                void                update_crossover_rank();
+                void                rebuild_gate_banks();
+                bool                update_band_activity();
+                void                update_latency();
+                size_t              crossover_rank(split_t * const *splits, size_t nsplits) const;
+                size_t              overload_rank(size_t rank) const;
+                bool                analyzer_busy() const;
+                void                wait_analyzer();
+                bool                configure_analyzer();
+                void                reconfigure_analyzer();
+                bool                commit_analyzer();
+                void                update_freq_charts();
+                void                restart_engine(channel_t *c);
+                void                crossfade_restart(channel_t *c, size_t samples);
+                void                update_spectral_masks();
+                void                update_static_gain();
+                void                apply_spectral_gain(channel_t *c, float *spectrum, size_t rank);
+                size_t              decimate_analyzer(size_t samples);
+                void                push_analyzer(size_t samples);
+                void                submit_analyzer();
+                void                process_analyzer();
                 void                output_meters();
                 void                do_destroy();
 
@@ -257,6 +535,7 @@ namespace lsp
                 virtual void        update_settings() override;
                 virtual void        process(size_t samples) override;
                 virtual void        ui_activated() override;
+                virtual void        ui_deactivated() override;
                 virtual bool        inline_display(plug::ICanvas *cv, size_t width, size_t height) override;
                 virtual void        dump(dspu::IStateDumper *v) const override;
         };
@@ -40,6 +40,46 @@
 	<?php } ?>
 	<li><b>Filters<?= $sm ?></b> - enables drawing transfer function of each sidechain filter on the spectrum graph.</li>
 	<li><b>Zoom</b> - zoom fader, allows to adjust zoom on the frequency chart.</li>
+	<li><b>Overload Guard</b> - when enabled, the plugin measures the time spent on processing of each block and, if it takes too
+	much of the real time, sequentially degrades the processing to avoid audio dropouts: disables the spectrum analysis, then freezes
+	the metering and graphs, then lowers the rate of envelope computation and at last lowers the precision of the crossover.
+	Lowering the precision of the crossover changes the latency, so this last step is performed only when <b>Latency Lock</b> is enabled.
+	The crossover restarts then, and until it delivers the valid output again the plugin outputs the delayed input with short crossfades.
+	The processing is restored back step-by-step when the load becomes low enough. The guard should be kept disabled for offline rendering.</li>
+	<li><b>Tier</b> - the current degradation tier of the overload guard, 0 means no degradation.</li>
+	<li><b>Crossover</b> - the quality profile of the crossover which defines the size of FFT frame independently of the sample rate:</li>
+	<ul>
+		<li><b>Economy</b> - the minimal FFT frame which still provides enough frequency resolution for the lowest split frequency and the
+		steepest filter slope. For high split frequencies this lowers the latency, CPU usage and memory consumption several times,
+		the filters at the lowest split may become less steep than set.</li>
+		<li><b>Standard</b> - the FFT frame is selected by the sample rate, this is the default behaviour.</li>
+		<li><b>High</b> - the FFT frame is doubled relative to the standard profile. The filters become steeper and more precise at low
+		frequencies at the cost of doubled latency and memory consumption and a bit higher CPU usage.</li>
+	</ul>
+	<li><b>Multirate</b> - computes the punch detector, punch filter and beat processor envelopes of low-frequency bands at the sample rate
+	decimated up to 8 times. The decimation is chosen per band by its upper split frequency, the band signal itself is still processed
+	at the full sample rate. This noticeably lowers CPU usage when there are many low-frequency bands, the envelope timing becomes
+	slightly coarser.</li>
+	<li><b>Spectral</b> - enables the spectral gain mode. Instead of synthesizing each band with a separate inverse FFT,
+	the plugin estimates the energy of each band from the spectrum of the channel, computes the punch detector, punch filter
+	and beat processor gains from it and applies them to the spectrum as a per-bin gain, so only one inverse FFT per channel
+	is performed. The envelopes are updated once per half of the FFT frame (about 46 ms at 44.1 kHz with the standard crossover
+	quality) instead of each sample, so fast transients are processed with coarser time resolution. Punch filter lookahead and
+	beat processor time shift are not applied, stereo channels are always processed independently, the <b>PD</b> and <b>PF</b>
+	listen modes pass the band signal unprocessed and the punch detector graph is not updated. When the mode is toggled, the newly
+	selected processing starts from the clean state and the delayed input replaces its output with short crossfades until
+	it delivers the valid output.</li>
+	<li><b>Early Detection</b> - feeds the punch detector of each band from an estimate of the band computed by IIR filters
+	on the undelayed input instead of the crossover output. The estimate is available before the crossover delivers the band,
+	so the punch detector latency, punch filter lookahead and beat processor time shift are realized within the crossover latency
+	and the plugin latency becomes the largest of them instead of their sum. The IIR filters only approximate the crossover
+	filters, so the detection may slightly differ from the normal mode, the group delay of the IIR filters at the center of the
+	band is compensated. The band signal and the input level meter of the band are still taken from the crossover.
+	Has no effect in the spectral gain mode.</li>
+	<li><b>Latency Lock</b> - always reports the maximum latency the plugin may have at the current sample rate and delays the
+	output internally to match it. Changing the punch detector, punch filter lookahead, beat processor time shift, crossover quality
+	and other settings affecting the latency does not force the host to recompute the delay compensation then, at the cost of
+	higher overall latency.</li>
 </ul>
 <p><b>'Analysis' section:</b></p>
 <ul>
@@ -62,10 +102,14 @@
 <ul>
 	<li><b>Band</b> - the button that enables the corresponding band. Band #1 is always enabled and can not be disabled.</li>
 	<li><b>S</b> - turn on the soloing mode of the corresponding band.</li>
-	<li><b>M</b> - mute the corresponding band.</li>
+	<li><b>M</b> - mute the corresponding band. The muted band is faded out and then excluded from the processing,
+	its meters are not updated. After unmuting, the band becomes audible with a short fade when the latency of the band
+	processing has passed, so its envelopes are estimated from the actual signal.</li>
 	<li><b>Chain output</b> - output the signal from the selected chain:</li>
 	<ul>
-		<li><b>BF</b> - output the signal directly from Band Filter.</li>
+		<li><b>BF</b> - output the signal directly from Band Filter. When all active bands are in this mode, the plugin applies
+		the combined frequency response of all bands at once as a single static filter. The latency stays the same, and the switch
+		to or from the static filter is crossfaded through the delayed input like the toggle of the spectral gain mode.</li>
 		<li><b>PD</b> - output the signal directly from Punch Detector.</li>
 		<li><b>PF</b> - output the signal directly from Punch Filter.</li>
 		<li><b>BP</b> - output the signal directly from Beat Processor (default).</li>
@@ -79,7 +123,8 @@
 	<li><b>HPF</b> - the slope of the hi-pass filter for the corresponding band.</li>
 	<li><b>LPF</b> - the slope of the lo-pass filter for the corresponding band.</li>
 	<li><b>Flatten</b> - the additional flattening of the band by cutting the high cap of the band.</li>
-	<li><b>Gain</b> - the output gain of the band.</li>
+	<li><b>Gain</b> - the output gain of the band. The band with -inf dB gain is excluded from the processing like the muted
+	band while the plugin window is closed or the meters are frozen by the overload guard.</li>
 </ul>
 <p><b>'Punch Detector' tab:</b></p>
 <ul>
@@ -26,7 +26,7 @@
 
 #define LSP_PLUGINS_BEAT_BREATHER_VERSION_MAJOR       1
 #define LSP_PLUGINS_BEAT_BREATHER_VERSION_MINOR       0
-#define LSP_PLUGINS_BEAT_BREATHER_VERSION_MICRO       20
+#define LSP_PLUGINS_BEAT_BREATHER_VERSION_MICRO       21
 
 #define LSP_PLUGINS_BEAT_BREATHER_VERSION  \
     LSP_MODULE_VERSION( \
@@ -50,6 +50,14 @@ namespace lsp
             { NULL, NULL }
         };
 
+        static const port_item_t bb_xover_quality[] =
+        {
+            { "Economy",        "beat_breather.xover_quality.economy"   },
+            { "Standard",       "beat_breather.xover_quality.standard"  },
+            { "High",           "beat_breather.xover_quality.high"      },
+            { NULL, NULL }
+        };
+
         #define BB_COMMON \
             BYPASS, \
             IN_GAIN, \
@@ -61,7 +69,14 @@ namespace lsp
             LOG_CONTROL("react", "FFT reactivity", "Reactivity", U_MSEC, beat_breather::FFT_REACT_TIME), \
             CONTROL("shift", "FFT shift gain", "FFT shift", U_DB, beat_breather::FFT_SHIFT), \
             LOG_CONTROL("zoom", "Graph zoom", "Zoom", U_GAIN_AMP, beat_breather::ZOOM), \
-            SWITCH("flt", "Show filters", "Show flt", 1.0f)
+            SWITCH("flt", "Show filters", "Show flt", 1.0f), \
+            SWITCH("ovlg", "Overload guard", "Ovl guard", 0.0f), \
+            METER("ovlt", "Overload degradation tier", U_NONE, beat_breather::OVL_TIER), \
+            COMBO("xq", "Crossover quality", "Xover quality", beat_breather::XOVER_QUALITY_DFL, bb_xover_quality), \
+            SWITCH("mrate", "Multirate low bands", "Multirate", 0.0f), \
+            SWITCH("spec", "Spectral gain mode", "Spectral", 0.0f), \
+            SWITCH("edet", "Early detection", "Early det", 0.0f), \
+            SWITCH("llock", "Latency lock", "Lat lock", 0.0f)
 
         #define BB_COMMON_STEREO \
             SWITCH("ssplit", "Stereo split", "Stereo split", 0.0f)
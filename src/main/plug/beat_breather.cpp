@@ -20,12 +20,15 @@
  */
 
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/common/bits.h>
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/dsp-units/misc/envelope.h>
 #include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/ipc/Thread.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/runtime/system.h>
 #include <lsp-plug.in/shared/debug.h>
 #include <lsp-plug.in/shared/id_colors.h>
 
@@ -37,6 +40,143 @@ namespace lsp
     {
         /* The size of temporary buffer for audio processing */
         static constexpr size_t BUFFER_SIZE = 0x1000;
+        /* The size of sample rings passing the data to the analyzer worker, should be power of two */
+        static constexpr size_t ANALYZER_RING_SIZE  = BUFFER_SIZE * 8;
+        /* The duration of the gain ramp applied to the band on mute and unmute, milliseconds */
+        static constexpr float  MUTE_RAMP_TIME      = 5.0f;
+        /* The duration of the crossfade from the delayed input to the output of the restarted engine, milliseconds */
+        static constexpr float  RESTART_FADE_TIME   = 10.0f;
+        /* The relative frequency span used for estimation of the group delay of early band estimates */
+        static constexpr float  EARLY_GD_SPAN       = 0.01f;
+        /* The Kaiser window parameter of the half-band filter decimating the analyzer input, about 80 dB of stopband attenuation */
+        static constexpr float  HALFBAND_BETA       = 7.86f;
+
+        //---------------------------------------------------------------------
+        // Gate curve cache shared between all plugin instances
+        static constexpr size_t CURVE_CACHE_SIZE        = 32;       // Number of cached curves
+        static constexpr size_t CURVE_CACHE_KEY         = 5;        // Curve type, threshold, zone, reduction, makeup
+        static constexpr float  CURVE_CACHE_QUANTIZE    = 100.0f;   // Key quantization: 0.01 dB
+
+        typedef struct curve_cache_entry_t
+        {
+            int32_t             vKey[CURVE_CACHE_KEY];                          // Quantized gate settings
+            uint32_t            nStamp;                                         // Last access time, zero for empty entry
+            float               vCurve[meta::beat_breather::CURVE_MESH_POINTS]; // Curve with applied makeup gain
+        } curve_cache_entry_t;
+
+        static curve_cache_entry_t  curve_cache[CURVE_CACHE_SIZE];
+        static uint32_t             curve_cache_clock   = 0;
+        static atomic_t             curve_cache_lock    = 0;
+
+        //---------------------------------------------------------------------
+        // Registry of crossover phase slots shared between all plugin instances
+        static constexpr size_t PHASE_SLOTS             = 256;      // Maximum number of registered channels
+
+        static atomic_t             phase_slots[PHASE_SLOTS];      // Non-zero value marks the slot as taken
+
+        //---------------------------------------------------------------------
+        // Processing kernels
+
+        /* Multiplies the signal by optional VCA and non-unity gain, stores or adds it to the destination and tracks the peak */
+        template <bool GAIN, bool VCA, bool ADD, bool PEAK>
+        static float fused_kernel(float *dst, const float *src, const float *vca, float gain, size_t count)
+        {
+            float peak          = 0.0f;
+            for (size_t i=0; i<count; ++i)
+            {
+                float s             = (GAIN) ? src[i] * gain : src[i];
+                if (VCA)
+                    s                  *= vca[i];
+                if (PEAK)
+                    peak                = lsp_max(peak, fabsf(s));
+                dst[i]              = (ADD) ? dst[i] + s : s;
+            }
+            return peak;
+        }
+
+        typedef float (* fused_kernel_t)(float *dst, const float *src, const float *vca, float gain, size_t count);
+
+        /* Fused kernels indexed by (GAIN << 3) | (VCA << 2) | (ADD << 1) | PEAK */
+        static const fused_kernel_t fused_kernels[] =
+        {
+            fused_kernel<false, false, false, false>,
+            fused_kernel<false, false, false, true>,
+            fused_kernel<false, false, true, false>,
+            fused_kernel<false, false, true, true>,
+            fused_kernel<false, true, false, false>,
+            fused_kernel<false, true, false, true>,
+            fused_kernel<false, true, true, false>,
+            fused_kernel<false, true, true, true>,
+            fused_kernel<true, false, false, false>,
+            fused_kernel<true, false, false, true>,
+            fused_kernel<true, false, true, false>,
+            fused_kernel<true, false, true, true>,
+            fused_kernel<true, true, false, false>,
+            fused_kernel<true, true, false, true>,
+            fused_kernel<true, true, true, false>,
+            fused_kernel<true, true, true, true>
+        };
+
+        /* Envelope follower of the gate bank, advances all lanes of the interleaved buffer at once */
+        template <size_t LANES>
+        static void gate_bank_envelope(float *buf, float *env, const float *tau_attack, const float *tau_release, size_t samples)
+        {
+            float e[LANES], ta[LANES], tr[LANES];
+            for (size_t j=0; j<LANES; ++j)
+            {
+                e[j]                = env[j];
+                ta[j]               = tau_attack[j];
+                tr[j]               = tau_release[j];
+            }
+
+            for (size_t i=0; i<samples; ++i, buf += LANES)
+            {
+                for (size_t j=0; j<LANES; ++j)
+                {
+                    const float d       = buf[j] - e[j];
+                    e[j]               += ((d > 0.0f) ? ta[j] : tr[j]) * d;
+                    buf[j]              = e[j];
+                }
+            }
+
+            for (size_t j=0; j<LANES; ++j)
+                env[j]              = e[j];
+        }
+
+        /* Modified Bessel function of the first kind and zero order, used by the Kaiser window */
+        static float bessel_i0(float x)
+        {
+            const float q       = x * x * 0.25f;
+            float sum           = 1.0f;
+            float term          = 1.0f;
+            for (size_t k=1; (k < 64) && (term > sum * 1e-9f); ++k)
+            {
+                term               *= q / float(k * k);
+                sum                += term;
+            }
+            return sum;
+        }
+
+        /* Computes odd coefficients of the Kaiser-windowed half-band low-pass filter, the center coefficient is 0.5 */
+        static void halfband_coefficients(float *fir, size_t count, float beta)
+        {
+            const float center  = float(count * 2 - 1);
+            const float norm    = 1.0f / bessel_i0(beta);
+            float sum           = 0.0f;
+            for (size_t k=0; k<count; ++k)
+            {
+                const float n       = float(k * 2 + 1);
+                const float r       = n / center;
+                const float w       = bessel_i0(beta * sqrtf(lsp_max(1.0f - r * r, 0.0f))) * norm;
+                fir[k]              = w * sinf(M_PI * n * 0.5f) / (M_PI * n);
+                sum                += fir[k];
+            }
+
+            // Normalize the gain at DC to unity
+            const float k       = 0.25f / sum;
+            for (size_t i=0; i<count; ++i)
+                fir[i]             *= k;
+        }
 
         //---------------------------------------------------------------------
         // Plugin factory
@@ -53,10 +193,29 @@ namespace lsp
 
         static plug::Factory factory(plugin_factory, plugins, 2);
 
+        //---------------------------------------------------------------------
+        // Analyzer worker
+        beat_breather::AnalyzerTask::AnalyzerTask(beat_breather *core)
+        {
+            pCore           = core;
+        }
+
+        beat_breather::AnalyzerTask::~AnalyzerTask()
+        {
+            pCore           = NULL;
+        }
+
+        status_t beat_breather::AnalyzerTask::run()
+        {
+            pCore->process_analyzer();
+            return STATUS_OK;
+        }
+
         //---------------------------------------------------------------------
         // Implementation
         beat_breather::beat_breather(const meta::plugin_t *meta):
-            Module(meta)
+            Module(meta),
+            sAnTask(this)
         {
             nChannels       = 1;
             if (!strcmp(meta->uid, meta::beat_breather_stereo.uid))
@@ -68,11 +227,59 @@ namespace lsp
             fDryGain        = GAIN_AMP_M_INF_DB;
             fWetGain        = GAIN_AMP_0_DB;
             fZoom           = GAIN_AMP_0_DB;
+            fMuteStep       = 1.0f;
+            fRestartStep    = 1.0f;
+            nTab            = meta::beat_breather::TAB_BAND_FILTER;
+            nFftRank        = 0;
+            nXoverRank      = 0;
+            nMaxBandLatency = 0;
+            nLockLatency    = 0;
+            nCtlRate        = 1;
+            nCtlPhase       = 0;
+            bOvlGuard       = false;
+            nOvlTier        = meta::beat_breather::OVL_NONE;
+            nOvlHigh        = 0;
+            nOvlLow         = 0;
+            nOvlBackoff     = 0;
+            bIdleSync       = false;
+            bUIActive       = false;
+            fOvlLoad        = 0.0f;
 
             vAnalyze[0]     = NULL;
             vAnalyze[1]     = NULL;
             vAnalyze[2]     = NULL;
             vAnalyze[3]     = NULL;
+            for (size_t i=0; i<4; ++i)
+            {
+                vAnRing[i]      = NULL;
+                vAnData[i]      = NULL;
+            }
+            halfband_coefficients(vAnFir, HALFBAND_ODD, HALFBAND_BETA);
+            nAnDecimation   = 1;
+            nAnStages       = 0;
+            nAnHead         = 0;
+            nAnTail         = 0;
+            bAnSync         = false;
+            bAnReconfig     = false;
+            bAnFreqs        = false;
+            pExecutor       = NULL;
+
+            bMultirate      = false;
+            bSpectral       = false;
+            bEarly          = false;
+            bLatencyLock    = false;
+            nEngine         = ENGINE_CROSSOVER;
+            bSpcSync        = true;
+            nSpcBins        = 0;
+            vSpcMask        = NULL;
+            vSpcGain        = NULL;
+            vSpcPower       = NULL;
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+            {
+                init_gate_bank(&vPfBanks[i]);
+                init_gate_bank(&vBpBanks[i]);
+                init_rms_bank(&vRmsBanks[i], nChannels * meta::beat_breather::BANDS_MAX);
+            }
 
             for (size_t i=0; i<meta::beat_breather::BANDS_MAX-1; ++i)
             {
@@ -89,6 +296,8 @@ namespace lsp
             vBuffer         = NULL;
             vFftFreqs       = NULL;
             vFftIndexes     = NULL;
+            vAnFreqs        = NULL;
+            vAnIndexes      = NULL;
             vPdMesh         = NULL;
             vPfMesh         = NULL;
             vBpMesh         = NULL;
@@ -99,14 +308,25 @@ namespace lsp
             pWetGain        = NULL;
             pDryWet         = NULL;
             pOutGain        = NULL;
+            pTabSel         = NULL;
             pStereoSplit    = NULL;
             pFFTReactivity  = NULL;
             pFFTShift       = NULL;
             pZoom           = NULL;
+            pOvlGuard       = NULL;
+            pOvlTier        = NULL;
+            pXoverQuality   = NULL;
+            pMultirate      = NULL;
+            pSpectral       = NULL;
+            pEarly          = NULL;
+            pLatencyLock    = NULL;
 
             pIDisplay       = NULL;
 
             pData           = NULL;
+            pRmsData        = NULL;
+            pRingData       = NULL;
+            pSpcData        = NULL;
         }
 
         beat_breather::~beat_breather()
@@ -122,6 +342,9 @@ namespace lsp
 
         void beat_breather::do_destroy()
         {
+            // The analyzer worker should not access the data being destroyed
+            wait_analyzer();
+
             // Destroy channels
             if (vChannels != NULL)
             {
@@ -129,25 +352,22 @@ namespace lsp
                 {
                     channel_t *c    = &vChannels[i];
 
+                    release_phase_slot(c->nPhaseSlot);
+                    c->nPhaseSlot   = -1;
+
                     c->sBypass.destroy();
                     c->sCrossover.destroy();
-                    c->sDelay.destroy();
-                    c->sDryDelay.destroy();
+                    c->sSpectral.destroy();
 
                     for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                     {
                         band_t *b               = &c->vBands[j];
 
-                        b->sDelay.destroy();
-                        b->sPdLong.destroy();
-                        b->sPdShort.destroy();
-                        b->sPdDelay.destroy();
                         b->sPdMeter.destroy();
                         b->sPf.destroy();
-                        b->sPfDelay.destroy();
                         b->sBp.destroy();
-                        b->sBpScDelay.destroy();
-                        b->sBpDelay.destroy();
+                        b->sEarlyHpf.destroy();
+                        b->sEarlyLpf.destroy();
                     }
                 }
                 vChannels   = NULL;
@@ -166,6 +386,36 @@ namespace lsp
                 free_aligned(pData);
                 pData       = NULL;
             }
+
+            // Free the history of RMS estimators
+            if (pRmsData != NULL)
+            {
+                free_aligned(pRmsData);
+                pRmsData    = NULL;
+            }
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+            {
+                vRmsBanks[i].vHistory   = NULL;
+                vRmsBanks[i].nCapacity  = 0;
+            }
+
+            // Free the delay rings
+            if (pRingData != NULL)
+            {
+                free_aligned(pRingData);
+                pRingData   = NULL;
+            }
+
+            // Free the band masks of the spectral gain mode
+            if (pSpcData != NULL)
+            {
+                free_aligned(pSpcData);
+                pSpcData    = NULL;
+            }
+            vSpcMask    = NULL;
+            vSpcGain    = NULL;
+            vSpcPower   = NULL;
+            nSpcBins    = 0;
         }
 
         void beat_breather::init(plug::IWrapper *wrapper, plug::IPort **ports)
@@ -173,10 +423,11 @@ namespace lsp
             // Call parent class for initialization
             Module::init(wrapper, ports);
 
-            // Initialize analyzer
+            // Initialize analyzer and obtain the executor for the analyzer worker
+            pExecutor               = wrapper->executor();
             size_t an_cid           = 0;
             if (!sAnalyzer.init(2*nChannels, meta::beat_breather::FFT_ANALYZER_RANK,
-                MAX_SAMPLE_RATE, meta::beat_breather::FFT_ANALYZER_RATE))
+                meta::beat_breather::FFT_ANALYZER_FREQ * 2, meta::beat_breather::FFT_ANALYZER_RATE))
                 return;
 
             sAnalyzer.set_rank(meta::beat_breather::FFT_ANALYZER_RANK);
@@ -194,15 +445,19 @@ namespace lsp
             const size_t szof_ffti      = align_size(sizeof(uint32_t) * meta::beat_breather::FFT_MESH_POINTS, DEFAULT_ALIGN);
             const size_t szof_curve     = align_size(sizeof(float) * meta::beat_breather::CURVE_MESH_POINTS, DEFAULT_ALIGN);
             const size_t szof_time      = align_size(sizeof(float) * meta::beat_breather::TIME_MESH_POINTS, DEFAULT_ALIGN);
+            const size_t szof_an_ring   = align_size(sizeof(float) * ANALYZER_RING_SIZE, DEFAULT_ALIGN);
             const size_t to_alloc       =
                 szof_channels +             // vChannels
                 szof_buffer +               // vBuffer
                 szof_fft +                  // vFftFreqs
                 szof_ffti +                 // vFftIndexes
+                szof_fft +                  // vAnFreqs
+                szof_ffti +                 // vAnIndexes
                 szof_time +                 // vPdMesh
                 szof_curve +                // vPfMesh
                 szof_curve +                // vBpMesh
                 nChannels * (
+                    szof_an_ring * 2 +  // vAnRing
                     szof_buffer +       // channel_t::vInData
                     szof_buffer +       // channel_t::vOutData
                     szof_fft +          // channel_t::vFreqChart
@@ -228,6 +483,10 @@ namespace lsp
             vBuffer                 = advance_ptr_bytes<float>(ptr, szof_buffer);
             vFftFreqs               = advance_ptr_bytes<float>(ptr, szof_fft);
             vFftIndexes             = advance_ptr_bytes<uint32_t>(ptr, szof_ffti);
+            vAnFreqs                = advance_ptr_bytes<float>(ptr, szof_fft);
+            vAnIndexes              = advance_ptr_bytes<uint32_t>(ptr, szof_ffti);
+            dsp::fill_zero(vFftFreqs, meta::beat_breather::FFT_MESH_POINTS);
+            memset(vFftIndexes, 0, sizeof(uint32_t) * meta::beat_breather::FFT_MESH_POINTS);
             vPdMesh                 = advance_ptr_bytes<float>(ptr, szof_time);
             vPfMesh                 = advance_ptr_bytes<float>(ptr, szof_curve);
             vBpMesh                 = advance_ptr_bytes<float>(ptr, szof_curve);
@@ -239,31 +498,35 @@ namespace lsp
 
                 c->sBypass.construct();
                 c->sCrossover.construct();
-                c->sDelay.construct();
-                c->sDryDelay.construct();
+                c->sSpectral.construct();
+                init_ring(&c->sHistory, NULL, 0);
+                init_ring(&c->sPadRing, NULL, 0);
+                c->nPadDelay            = 0;
+                c->bRestart             = false;
+                c->nRestart             = 0;
+                c->nRestartHold         = 0;
+                c->nPhaseSlot           = -1;
 
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *b               = &c->vBands[j];
 
-                    b->sDelay.construct();
-                    b->sPdLong.construct();
-                    if (!b->sPdLong.init(1, meta::beat_breather::PD_LONG_RMS_MAX))
-                        return;
-                    b->sPdShort.construct();
-                    if (!b->sPdShort.init(1, meta::beat_breather::PD_SHORT_RMS_MAX))
-                        return;
-                    b->sPdDelay.construct();
                     b->sPdMeter.construct();
                     b->sPf.construct();
-                    b->sPfDelay.construct();
                     b->sBp.construct();
-                    b->sBpScDelay.construct();
-                    b->sBpDelay.construct();
+                    b->sEarlyHpf.construct();
+                    b->sEarlyLpf.construct();
+                    b->sEarlyHpf.init(NULL);
+                    b->sEarlyLpf.init(NULL);
 
                     b->nOldMode             = BAND_OFF;
+                    b->nMixMode             = BAND_OFF;
                     b->nMode                = BAND_OFF;
                     b->fGain                = GAIN_AMP_0_DB;
+                    b->fMute                = 0.0f;
+                    b->bSilent              = false;
+                    b->bIdle                = false;
+                    b->nWarmup              = 0;
                     b->fInLevel             = GAIN_AMP_M_INF_DB;
                     b->fOutLevel            = GAIN_AMP_M_INF_DB;
                     b->fReduction           = GAIN_AMP_0_DB;
@@ -277,6 +540,38 @@ namespace lsp
                     b->fBpInGain            = GAIN_AMP_M_INF_DB;
                     b->fBpOutGain           = GAIN_AMP_M_INF_DB;
                     b->fBpReduction         = GAIN_AMP_M_INF_DB;
+                    b->fPdHold              = 0.0f;
+                    b->fPfHold              = 0.0f;
+                    b->fBpHold              = 0.0f;
+                    b->bBpSteady            = false;
+                    b->fBpSteady            = GAIN_AMP_0_DB;
+                    b->nCtlRate             = 1;
+                    b->nCtlGroup            = 0;
+                    b->fCtlTop              = 0.0f;
+                    b->fSpcLong             = 0.0f;
+                    b->fSpcShort            = 0.0f;
+                    b->fSpcPfEnv            = 0.0f;
+                    b->fSpcBpEnv            = 0.0f;
+                    b->fSpcLongTau          = 1.0f;
+                    b->fSpcShortTau         = 1.0f;
+                    b->fSpcPfAttack         = 1.0f;
+                    b->fSpcPfRelease        = 1.0f;
+                    b->fSpcBpAttack         = 1.0f;
+                    b->fSpcBpRelease        = 1.0f;
+                    b->fSpcBias             = GAIN_AMP_0_DB;
+
+                    init_ring(&b->sRing, NULL, 0);
+                    init_ring(&b->sPfRing, NULL, 0);
+                    init_ring(&b->sPdRing, NULL, 0);
+                    init_ring(&b->sBpScRing, NULL, 0);
+                    b->nCompDelay           = 0;
+                    b->nOutDelay            = 0;
+                    b->nEarlyDelay          = 0;
+                    b->nEarlyGd             = 0;
+                    b->nBpDelay             = 0;
+                    b->nPfDelay             = 0;
+                    b->nPdDelay             = 0;
+                    b->nBpScDelay           = 0;
 
                     b->vInData              = advance_ptr_bytes<float>(ptr, szof_buffer);
                     b->vPdData              = advance_ptr_bytes<float>(ptr, szof_buffer);
@@ -337,6 +632,8 @@ namespace lsp
                     b->pBpGainLevel         = NULL;
                 }
 
+                c->nPhaseSlot           = acquire_phase_slot();
+                c->nDelay               = 0;
                 c->nAnIn                = an_cid++;
                 c->nAnOut               = an_cid++;
                 c->fInLevel             = GAIN_AMP_M_INF_DB;
@@ -350,6 +647,8 @@ namespace lsp
 
                 vAnalyze[c->nAnIn]      = c->vInData;
                 vAnalyze[c->nAnOut]     = c->vOutData;
+                vAnRing[c->nAnIn]       = advance_ptr_bytes<float>(ptr, szof_an_ring);
+                vAnRing[c->nAnOut]      = advance_ptr_bytes<float>(ptr, szof_an_ring);
 
                 c->pIn                  = NULL;
                 c->pOut                 = NULL;
@@ -387,11 +686,18 @@ namespace lsp
             BIND_PORT(pWetGain);
             BIND_PORT(pDryWet);
             BIND_PORT(pOutGain);
-            SKIP_PORT("Tab selector"); // skip tab selector
+            BIND_PORT(pTabSel);
             BIND_PORT(pFFTReactivity);
             BIND_PORT(pFFTShift);
             BIND_PORT(pZoom);
             SKIP_PORT("Show filters"); // skip show filters
+            BIND_PORT(pOvlGuard);
+            BIND_PORT(pOvlTier);
+            BIND_PORT(pXoverQuality);
+            BIND_PORT(pMultirate);
+            BIND_PORT(pSpectral);
+            BIND_PORT(pEarly);
+            BIND_PORT(pLatencyLock);
             if (nChannels > 1)
                 BIND_PORT(pStereoSplit);
 
@@ -551,6 +857,38 @@ namespace lsp
             return meta::beat_breather::FFT_XOVER_RANK_MIN + n;
         }
 
+        bool beat_breather::band_processed(band_mode_t mode)
+        {
+            return mode != BAND_OFF;
+        }
+
+        bool beat_breather::band_mixed(band_mode_t mode)
+        {
+            return (mode != BAND_OFF) && (mode != BAND_MUTE);
+        }
+
+        bool beat_breather::band_active(const band_t *b)
+        {
+            // Muted bands are processed until they fade out, then they stay idle until unmute
+            return (band_processed(b->nMode)) && (!b->bIdle);
+        }
+
+        size_t beat_breather::select_analyzer_decimation(size_t sample_rate)
+        {
+            size_t k = 1;
+            while ((sample_rate / (k * 2)) >= meta::beat_breather::FFT_ANALYZER_FREQ)
+                k <<= 1;
+            return k;
+        }
+
+        size_t beat_breather::select_analyzer_rank(size_t sample_rate)
+        {
+            const size_t k = (meta::beat_breather::FFT_ANALYZER_FREQ + sample_rate - 1) / sample_rate;
+            const size_t n = int_log2(k);
+            return (meta::beat_breather::FFT_ANALYZER_RANK >= meta::beat_breather::FFT_ANALYZER_RANK_MIN + n) ?
+                meta::beat_breather::FFT_ANALYZER_RANK - n : meta::beat_breather::FFT_ANALYZER_RANK_MIN;
+        }
+
         void beat_breather::update_sample_rate(long sr)
         {
             const size_t fft_rank       = select_fft_rank(sr);
@@ -558,26 +896,53 @@ namespace lsp
                 (lsp_max(meta::beat_breather::PD_SHORT_RMS_MAX, meta::beat_breather::PD_LONG_RMS_MAX) + 1)/2);
             const size_t max_delay_pf   = dspu::millis_to_samples(sr, meta::beat_breather::PF_LOOKAHEAD_MAX);
             const size_t max_delay_bp   = dspu::millis_to_samples(sr, meta::beat_breather::BP_TIME_SHIFT_MAX);
-            const size_t max_delay_fft  = (1 << fft_rank);
+            const size_t max_fft_rank   = fft_rank + 1;     // The high quality profile doubles the resolution
+            const size_t max_delay_fft  = (1 << max_fft_rank);
             const size_t samples_per_dot= dspu::seconds_to_samples(sr, meta::beat_breather::TIME_HISTORY_MAX / meta::beat_breather::TIME_MESH_POINTS);
 
+            // Wait for the analyzer worker and drop the data collected at previous sample rate
+            wait_analyzer();
+            nAnHead                     = 0;
+            nAnTail                     = 0;
+            nAnStages                   = lsp_min(size_t(int_log2(select_analyzer_decimation(sr))), size_t(HALFBAND_STAGES));
+            nAnDecimation               = size_t(1) << nAnStages;
+            for (size_t i=0; i<4; ++i)
+                for (size_t j=0; j<HALFBAND_STAGES; ++j)
+                {
+                    halfband_t *hb              = &vAnStages[i][j];
+                    hb->nHead                   = 0;
+                    hb->nPhase                  = 0;
+                    dsp::fill_zero(hb->vDelay, HALFBAND_TAPS * 2);
+                }
+
             sCounter.set_sample_rate(sr, true);
+            fMuteStep                   = 1.0f / lsp_max(dspu::millis_to_samples(sr, MUTE_RAMP_TIME), 1.0f);
+            fRestartStep                = 1.0f / lsp_max(dspu::millis_to_samples(sr, RESTART_FADE_TIME), 1.0f);
+            const bool xover_init       = fft_rank != nFftRank;
+            nFftRank                    = fft_rank;
 
             for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c            = &vChannels[i];
 
                 c->sBypass.init(sr);
-                c->sDelay.init(max_delay_fft + max_delay_pd + max_delay_pf + max_delay_bp + BUFFER_SIZE);
-                c->sDryDelay.init(max_delay_fft + max_delay_pd + max_delay_pf + max_delay_bp + BUFFER_SIZE);
 
-                if (fft_rank != c->sCrossover.rank())
+                // Each channel keeps its own crossover: dspu::FFTCrossover transforms a single real signal,
+                // and the frames of the channels are deliberately phase-shifted to spread the FFT load
+                if (xover_init)
                 {
-                    c->sCrossover.init(fft_rank, meta::beat_breather::BANDS_MAX);
+                    const float phase       = (c->nPhaseSlot >= 0) ? phase_slot_value(c->nPhaseSlot) : float(i) / float(nChannels);
+
+                    c->sCrossover.init(max_fft_rank, meta::beat_breather::BANDS_MAX);
                     for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                         c->sCrossover.set_handler(j, process_band, this, c);
                     c->sCrossover.set_rank(fft_rank);
-                    c->sCrossover.set_phase(float(i) / float(nChannels));
+                    c->sCrossover.set_phase(phase);
+
+                    c->sSpectral.init(max_fft_rank);
+                    c->sSpectral.bind(process_spectrum, this, c);
+                    c->sSpectral.set_rank(fft_rank);
+                    c->sSpectral.set_phase(phase);
                 }
                 c->sCrossover.set_sample_rate(sr);
 
@@ -585,32 +950,119 @@ namespace lsp
                 {
                     band_t *b               = &c->vBands[j];
 
-                    b->sDelay.init(max_delay_pd + max_delay_pf + max_delay_bp);
-                    b->sPdLong.set_sample_rate(sr);
-                    b->sPdShort.set_sample_rate(sr);
-                    b->sPdDelay.init(max_delay_pd);
                     b->sPdMeter.init(meta::beat_breather::TIME_MESH_POINTS, samples_per_dot);
                     b->sPf.set_sample_rate(sr);
-                    b->sPfDelay.init(max_delay_pf);
                     b->sBp.set_sample_rate(sr);
-                    b->sBpScDelay.init(max_delay_bp);
-                    b->sBpDelay.init(max_delay_pd + max_delay_pf + max_delay_bp);
                 }
             }
 
-            // Commit sample rate to analyzer
-            sAnalyzer.set_sample_rate(sr);
+            // Allocate input history of all channels and delay rings of all bands. Each ring carries a different
+            // signal: the band, the short-time RMS, the enveloped peak and the sidechain run at the control rate
+            // of the band, so they can not share one tapped ring. Taps of the same signal do share the ring:
+            // the history serves both the dry signal and the early estimates, the band ring both band taps
+            const size_t pf_capacity    = max_delay_pf + BUFFER_SIZE;
+            const size_t pd_capacity    = max_delay_pd + BUFFER_SIZE;
+            const size_t bp_capacity    = max_delay_bp + BUFFER_SIZE;
+            const size_t band_capacity  = max_delay_pd + max_delay_pf + max_delay_bp + BUFFER_SIZE;
+            const size_t hist_capacity  = max_delay_fft + band_capacity;
+            nLockLatency                = hist_capacity - BUFFER_SIZE;
+            const size_t szof_pf_ring   = align_size(sizeof(float) * pf_capacity, DEFAULT_ALIGN);
+            const size_t szof_pd_ring   = align_size(sizeof(float) * pd_capacity, DEFAULT_ALIGN);
+            const size_t szof_bp_ring   = align_size(sizeof(float) * bp_capacity, DEFAULT_ALIGN);
+            const size_t szof_band_ring = align_size(sizeof(float) * band_capacity, DEFAULT_ALIGN);
+            const size_t szof_history   = align_size(sizeof(float) * hist_capacity, DEFAULT_ALIGN);
+            if (pRingData != NULL)
+            {
+                free_aligned(pRingData);
+                pRingData                   = NULL;
+            }
+            uint8_t *ring_ptr           = alloc_aligned<uint8_t>(pRingData,
+                nChannels * (szof_history * 2 + meta::beat_breather::BANDS_MAX *
+                    (szof_pf_ring + szof_pd_ring + szof_bp_ring + szof_band_ring)));
+
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                init_ring(&c->sHistory, (ring_ptr != NULL) ? advance_ptr_bytes<float>(ring_ptr, szof_history) : NULL, hist_capacity);
+                init_ring(&c->sPadRing, (ring_ptr != NULL) ? advance_ptr_bytes<float>(ring_ptr, szof_history) : NULL, hist_capacity);
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b               = &c->vBands[j];
+                    init_ring(&b->sRing, (ring_ptr != NULL) ? advance_ptr_bytes<float>(ring_ptr, szof_band_ring) : NULL, band_capacity);
+                    init_ring(&b->sPfRing, (ring_ptr != NULL) ? advance_ptr_bytes<float>(ring_ptr, szof_pf_ring) : NULL, pf_capacity);
+                    init_ring(&b->sPdRing, (ring_ptr != NULL) ? advance_ptr_bytes<float>(ring_ptr, szof_pd_ring) : NULL, pd_capacity);
+                    init_ring(&b->sBpScRing, (ring_ptr != NULL) ? advance_ptr_bytes<float>(ring_ptr, szof_bp_ring) : NULL, bp_capacity);
+                    b->sEarlyHpf.clear();
+                    b->sEarlyLpf.clear();
+                }
+            }
+
+            // Allocate band masks of the spectral gain mode for the highest crossover rank, the per-bin gain and power
+            const size_t spc_bins       = (max_delay_fft >> 1) + 1;
+            if (spc_bins != nSpcBins)
+            {
+                if (pSpcData != NULL)
+                {
+                    free_aligned(pSpcData);
+                    pSpcData                    = NULL;
+                }
+
+                const size_t szof_masks     = align_size(sizeof(float) * spc_bins * meta::beat_breather::BANDS_MAX, DEFAULT_ALIGN);
+                const size_t szof_gain      = align_size(sizeof(float) * spc_bins, DEFAULT_ALIGN);
+                uint8_t *ptr                = alloc_aligned<uint8_t>(pSpcData, szof_masks + szof_gain * 2);
+                vSpcMask                    = (ptr != NULL) ? advance_ptr_bytes<float>(ptr, szof_masks) : NULL;
+                vSpcGain                    = (ptr != NULL) ? advance_ptr_bytes<float>(ptr, szof_gain) : NULL;
+                vSpcPower                   = (ptr != NULL) ? advance_ptr_bytes<float>(ptr, szof_gain) : NULL;
+                nSpcBins                    = (ptr != NULL) ? spc_bins : 0;
+            }
+            bSpcSync                    = true;
+
+            // Allocate the history of RMS estimators, the history of each control rate is shortened by the decimation
+            const size_t rms_capacity   = dspu::millis_to_samples(sr, meta::beat_breather::PD_LONG_RMS_MAX) + 1;
+            if (rms_capacity != vRmsBanks[0].nCapacity)
+            {
+                if (pRmsData != NULL)
+                {
+                    free_aligned(pRmsData);
+                    pRmsData                    = NULL;
+                }
+
+                size_t szof_history[CTL_GROUPS];
+                size_t to_alloc             = 0;
+                for (size_t i=0; i<CTL_GROUPS; ++i)
+                {
+                    szof_history[i]             = align_size(sizeof(float) * (((rms_capacity - 1) >> i) + 1) * vRmsBanks[i].nLanes, DEFAULT_ALIGN);
+                    to_alloc                   += szof_history[i];
+                }
+
+                uint8_t *ptr                = alloc_aligned<uint8_t>(pRmsData, to_alloc);
+                for (size_t i=0; i<CTL_GROUPS; ++i)
+                {
+                    rms_bank_t *rb              = &vRmsBanks[i];
+                    rb->vHistory                = (ptr != NULL) ? advance_ptr_bytes<float>(ptr, szof_history[i]) : NULL;
+                    rb->nCapacity               = (ptr != NULL) ? ((rms_capacity - 1) >> i) + 1 : 0;
+                }
+            }
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+                clear_rms_bank(&vRmsBanks[i]);
+
+            // Commit decimated sample rate and the rank of the same frequency resolution to analyzer
+            const size_t an_sr          = sr / nAnDecimation;
+            sAnalyzer.set_sample_rate(an_sr);
+            sAnalyzer.set_rank(select_analyzer_rank(an_sr));
         }
 
-        int beat_breather::compare_splits(const void *a1, const void *a2, void *data)
+        void beat_breather::sort_splits(split_t **splits, size_t count)
         {
-            const split_t * const * s1 = reinterpret_cast<const split_t * const *>(a1);
-            const split_t * const * s2 = reinterpret_cast<const split_t * const *>(a2);
-            if ((*s1)->fFrequency < (*s2)->fFrequency)
-                return -1;
-            else if ((*s1)->fFrequency > (*s2)->fFrequency)
-                return 1;
-            return 0;
+            // Insertion sort: there are only a few splits, and it never allocates memory unlike qsort_r()
+            for (size_t i=1; i<count; ++i)
+            {
+                split_t *sp         = splits[i];
+                size_t j            = i;
+                for ( ; (j > 0) && (splits[j-1]->fFrequency > sp->fFrequency); --j)
+                    splits[j]           = splits[j-1];
+                splits[j]           = sp;
+            }
         }
 
         beat_breather::band_mode_t beat_breather::decode_band_mode(size_t mode)
@@ -643,43 +1095,42 @@ namespace lsp
             fDryGain            = (dry_gain * drywet + 1.0f - drywet) * out_gain;
             fWetGain            = wet_gain * drywet * out_gain;
             fZoom               = pZoom->value();
-            size_t an_channels  = 0;
+            nTab                = size_t(pTabSel->value());
             bool bypass         = pBypass->value() >= 0.5f;
             bool sync           = false;
 
-            // Update analyzer settings
-            for (size_t i=0; i<nChannels; ++i)
+            // Configure overload guard and the degradation of processing
+            bOvlGuard           = pOvlGuard->value() >= 0.5f;
+            bMultirate          = pMultirate->value() >= 0.5f;
+            bSpectral           = pSpectral->value() >= 0.5f;
+            const bool early    = pEarly->value() >= 0.5f;
+            const bool early_sync = early != bEarly;
+            bEarly              = early;
+            bLatencyLock        = pLatencyLock->value() >= 0.5f;
+            // The crossover tier changes the latency, so it is only allowed while the latency is locked
+            if ((!bLatencyLock) && (nOvlTier > meta::beat_breather::OVL_ENVELOPE))
+                nOvlTier            = meta::beat_breather::OVL_ENVELOPE;
+            if (!bOvlGuard)
             {
-                channel_t *c    = &vChannels[i];
-
-                // Update analyzer settings
-                sAnalyzer.enable_channel(c->nAnIn, c->pInFft->value() >= 0.5f);
-                sAnalyzer.enable_channel(c->nAnOut, c->pOutFft->value() >= 0.5f);
-
-                if (sAnalyzer.channel_active(c->nAnIn))
-                    an_channels ++;
-                if (sAnalyzer.channel_active(c->nAnOut))
-                    an_channels ++;
+                nOvlTier            = meta::beat_breather::OVL_NONE;
+                nOvlHigh            = 0;
+                nOvlLow             = 0;
+                nOvlBackoff         = 0;
+                fOvlLoad            = 0.0f;
             }
 
-            // Update analyzer parameters
-            sAnalyzer.set_reactivity(pFFTReactivity->value());
-            if (pFFTShift != NULL)
-                sAnalyzer.set_shift(dspu::db_to_gain(pFFTShift->value()) * 100.0f);
-            sAnalyzer.set_activity(an_channels > 0);
-
-            if (sAnalyzer.needs_reconfiguration())
+            const size_t ctl_rate   = (nOvlTier >= meta::beat_breather::OVL_ENVELOPE) ? meta::beat_breather::OVL_CTL_DECIMATION : 1;
+            if (ctl_rate != nCtlRate)
             {
-                sAnalyzer.reconfigure();
-                sAnalyzer.get_frequencies(
-                    vFftFreqs,
-                    vFftIndexes,
-                    SPEC_FREQ_MIN,
-                    SPEC_FREQ_MAX,
-                    meta::beat_breather::FFT_MESH_POINTS);
-                sync                = true;
+                nCtlRate            = ctl_rate;
+                nCtlPhase           = 0;
             }
 
+            // Update analyzer settings, they are deferred while the analyzer worker owns the analyzer
+            bAnSync             = analyzer_busy();
+            if (!bAnSync)
+                sync                = configure_analyzer();
+
             // Configure splits and their order
             size_t nsplits  = 0;
             split_t *vsplits[meta::beat_breather::BANDS_MAX];
@@ -693,17 +1144,25 @@ namespace lsp
                 if (sp->bEnabled)
                     vsplits[nsplits++]  = sp;
             }
-            if (nsplits > 1)
-                lsp::qsort_r(vsplits, nsplits, sizeof(split_t *), compare_splits, NULL);
+            sort_splits(vsplits, nsplits);
+            nXoverRank              = crossover_rank(vsplits, nsplits);
+            const size_t fft_rank   = overload_rank(nXoverRank);
+            // The spectral processor advances by half of the frame
+            const float spc_frame_rate  = (fft_rank > 0) ? fSampleRate / float(size_t(1) << (fft_rank - 1)) : fSampleRate;
 
             // Configure channels
             size_t max_band_latency     = 0;
+            bool xsync                  = false;
             for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c        = &vChannels[i];
                 bool has_solo       = false;
 
                 c->sBypass.set_bypass(bypass);
+                if ((nFftRank > 0) && (c->sCrossover.rank() != fft_rank))
+                    c->sCrossover.set_rank(fft_rank);
+                if ((nFftRank > 0) && (c->sSpectral.get_rank() != fft_rank))
+                    c->sSpectral.set_rank(fft_rank);
 
                 // Form the list of bands
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
@@ -711,6 +1170,7 @@ namespace lsp
                     band_t *b           = &c->vBands[j];
                     b->nOldMode         = b->nMode;
                     b->nMode            = BAND_OFF;
+                    b->nCtlRate         = nCtlRate;
                 }
 
                 // Configure active frequency bands
@@ -719,6 +1179,8 @@ namespace lsp
                     size_t band_id  = (j > 0) ? vsplits[j-1]->nBandId : 0;
                     band_t *b       = &c->vBands[band_id];
                     b->nMode        = decode_band_mode(b->pListen->value());
+                    b->fCtlTop      = (j < nsplits) ? vsplits[j]->fFrequency : fSampleRate * 0.5f;
+                    b->nCtlRate     = band_control_rate(b->fCtlTop);
 
                     // Configure hi-pass filter
                     if (j > 0)
@@ -726,9 +1188,13 @@ namespace lsp
                         c->sCrossover.enable_hpf(band_id, true);
                         c->sCrossover.set_hpf_frequency(band_id, vsplits[j-1]->fFrequency);
                         c->sCrossover.set_hpf_slope(band_id, - b->pHpfSlope->value());
+                        update_early_filter(&b->sEarlyHpf, dspu::FLT_BT_LRX_HIPASS, vsplits[j-1]->fFrequency, b->pHpfSlope->value());
                     }
                     else
+                    {
                         c->sCrossover.disable_hpf(band_id);
+                        update_early_filter(&b->sEarlyHpf, dspu::FLT_NONE, 0.0f, 0.0f);
+                    }
 
                     // Configure lo-pass filter
                     if (j < nsplits)
@@ -736,16 +1202,26 @@ namespace lsp
                         c->sCrossover.enable_lpf(band_id, true);
                         c->sCrossover.set_lpf_frequency(band_id, vsplits[j]->fFrequency);
                         c->sCrossover.set_lpf_slope(band_id, - b->pLpfSlope->value());
+                        update_early_filter(&b->sEarlyLpf, dspu::FLT_BT_LRX_LOPASS, vsplits[j]->fFrequency, b->pLpfSlope->value());
                         b->pFreqEnd->set_value(vsplits[j]->fFrequency);
                     }
                     else
                     {
                         c->sCrossover.disable_lpf(band_id);
+                        update_early_filter(&b->sEarlyLpf, dspu::FLT_NONE, 0.0f, 0.0f);
                         b->pFreqEnd->set_value(fSampleRate * 0.5f);
                     }
 
                     c->sCrossover.set_flatten(band_id, dspu::db_to_gain(-b->pFlatten->value()));
 
+                    // Group delay of the early band estimate at the geometric center of the band
+                    const float f_lo    = (j > 0) ? vsplits[j-1]->fFrequency : 0.0f;
+                    const float f_hi    = (j < nsplits) ? vsplits[j]->fFrequency : fSampleRate * 0.5f;
+                    const float f_mid   = (j == 0) ? f_hi * 0.5f :
+                                          (j == nsplits) ? lsp_min(f_lo * 2.0f, fSampleRate * 0.25f) :
+                                          sqrtf(f_lo * f_hi);
+                    b->nEarlyGd         = early_group_delay(b, f_mid);
+
                     // Check solo option
                     if (b->pSolo->value() >= 0.5f)
                         has_solo        = true;
@@ -758,33 +1234,29 @@ namespace lsp
 
                     bool solo               = b->pSolo->value() >= 0.5f;
                     bool mute               = ((has_solo) && (!solo)) ? true : b->pMute->value() >= 0.5f;
+                    b->fGain                = b->pOutGain->value();
                     if ((mute) && (b->nMode != BAND_OFF))
                         b->nMode                = BAND_MUTE;
 
-                    b->fGain                = b->pOutGain->value();
+                    // The muted band fades out in the last audible mode, the enabled band starts without a ramp
+                    if (band_mixed(b->nMode))
+                        b->nMixMode             = b->nMode;
+                    if (b->nMode == BAND_OFF)
+                        b->fMute                = 0.0f;
+                    else if (b->nOldMode == BAND_OFF)
+                        b->fMute                = (b->nMode != BAND_MUTE) ? 1.0f : 0.0f;
 
-                    // Do we have hi-pass filter?
-                    c->sCrossover.enable_band(j, b->nMode != BAND_OFF);
+                    // The idle band is not synthesized, update_band_activity() wakes it up after unmute
+                    if (b->nMode == BAND_OFF)
+                        b->bIdle                = false;
+                    c->sCrossover.enable_band(j, band_active(b));
 
                     // Update Peak detector configuration
-                    float pd_long           = b->pPdLongTime->value();
-                    float pd_short          = b->pPdShortTime->value();
-                    size_t pd_short_latency = dspu::millis_to_samples(fSampleRate, pd_long - pd_short) / 2;
-                    size_t pd_latency       = dspu::millis_to_samples(fSampleRate, pd_long) / 2;
-                    float pd_bias           = dspu::db_to_gain(b->pPdBias->value());
+                    size_t pd_latency       = dspu::millis_to_samples(fSampleRate, b->pPdLongTime->value()) / 2;
                     b->fPdMakeup            = dspu::db_to_gain(b->pPdMakeup->value() + meta::beat_breather::PD_MAKEUP_SHIFT);
 
-                    b->sPdLong.set_mode(dspu::SCM_RMS);
-                    b->sPdLong.set_source(dspu::SCS_MIDDLE);
-                    b->sPdLong.set_reactivity(pd_long);
-                    b->sPdLong.set_gain(GAIN_AMP_0_DB);
-
-                    b->sPdShort.set_mode(dspu::SCM_RMS);
-                    b->sPdShort.set_source(dspu::SCS_MIDDLE);
-                    b->sPdShort.set_reactivity(pd_short);
-                    b->sPdShort.set_gain(pd_bias);
-
-                    b->sPdDelay.set_delay(pd_short_latency);
+                    // Envelope estimators and control delays depend on the control rate, the enabled band starts from silence
+                    configure_band_control(b, i * meta::beat_breather::BANDS_MAX + j, b->nOldMode != BAND_OFF);
 
                     b->sPdMeter.set_method(dspu::MM_ABS_MAXIMUM);
                     if ((b->nOldMode != BAND_OFF) && (b->nMode == BAND_OFF))
@@ -795,211 +1267,1135 @@ namespace lsp
                     float pf_zone           = b->pPfZone->value();
                     size_t pf_latency       = dspu::millis_to_samples(fSampleRate, b->pPfLookahead->value());
 
-                    b->sPf.set_attack(b->pPfAttack->value());
-                    b->sPf.set_release(b->pPfRelease->value());
                     b->sPf.set_threshold(pf_thresh, pf_thresh);
                     b->sPf.set_zone(pf_zone, pf_zone);
                     b->sPf.set_reduction(b->pPfReduction->value());
                     if (b->sPf.modified())
                     {
                         b->sPf.update_settings();
-                        if (i == 0)
-                            b->sPf.curve(b->vPfMesh, vPfMesh, meta::beat_breather::CURVE_MESH_POINTS, false);
-                        b->nSync               |= SYNC_PEAK_FILTER;
+                        b->nSync               |= SYNC_PEAK_CURVE;
+                    }
+                    // Compute the curve only when it is visible
+                    if ((i == 0) && (nTab == meta::beat_breather::TAB_PUNCH_FILTER) && (b->nSync & SYNC_PEAK_CURVE))
+                    {
+                        gate_curve(b->vPfMesh, &b->sPf, vPfMesh, SYNC_PEAK_FILTER,
+                            pf_thresh, pf_zone, b->pPfReduction->value(), GAIN_AMP_0_DB);
+                        b->nSync                = (b->nSync & (~SYNC_PEAK_CURVE)) | SYNC_PEAK_FILTER;
                     }
-
-                    b->sPfDelay.set_delay(pf_latency);
 
                     // Update beat processor configuration
                     float bp_ratio          = b->pBpRatio->value() - 1.0f;
                     float bp_shift          = b->pBpTimeShift->value();
-                    size_t bp_sc_latency    = dspu::millis_to_samples(fSampleRate, lsp_max(bp_shift, 0.0f));
                     size_t bp_latency       = dspu::millis_to_samples(fSampleRate, lsp_max(-bp_shift, 0.0f));
+                    float bp_th             = b->pBpThreshold->value();
+                    float bp_zone           = GAIN_AMP_0_DB;
+                    float bp_reduction      = GAIN_AMP_0_DB;
+                    b->fBpMakeup            = GAIN_AMP_0_DB;
                     if (bp_ratio >= 1e-3f)
                     {
                         float bp_max_gain       = b->pBpMaxGain->value();
                         float bp_user_th        = b->pBpThreshold->value();
                         float bp_log_th         = logf(bp_user_th);
                         float bp_log_gate_th    = logf(bp_max_gain) / bp_ratio + bp_log_th;
-                        float bp_th             = expf(bp_log_gate_th);
-                        float bp_zone           = bp_user_th / bp_th;
 
-                        b->sBp.set_threshold(bp_th, bp_th);
-                        b->sBp.set_reduction(1.0f / bp_max_gain);
-                        b->sBp.set_zone(bp_zone, bp_zone);
+                        bp_th                   = expf(bp_log_gate_th);
+                        bp_zone                 = bp_user_th / bp_th;
+                        bp_reduction            = 1.0f / bp_max_gain;
                         b->fBpMakeup            = bp_max_gain;
                     }
-                    else
-                    {
-                        float bp_th             = b->pBpThreshold->value();
-                        b->sBp.set_threshold(bp_th, bp_th);
-                        b->sBp.set_reduction(GAIN_AMP_0_DB);
-                        b->sBp.set_zone(GAIN_AMP_0_DB, GAIN_AMP_0_DB);
-                        b->fBpMakeup            = GAIN_AMP_0_DB;
-                    }
-
 
-                    b->sBp.set_attack(b->pBpAttack->value());
-                    b->sBp.set_release(b->pBpRelease->value());
+                    b->sBp.set_threshold(bp_th, bp_th);
+                    b->sBp.set_reduction(bp_reduction);
+                    b->sBp.set_zone(bp_zone, bp_zone);
 
                     if (b->sBp.modified())
                     {
                         b->sBp.update_settings();
-                        if (i == 0)
-                            b->sBp.curve(b->vBpMesh, vBpMesh, meta::beat_breather::CURVE_MESH_POINTS, false);
-                        b->nSync               |= SYNC_BEAT_PROC;
+                        b->nSync               |= SYNC_BEAT_CURVE;
+                    }
+                    // Compute the curve only when it is visible
+                    if ((i == 0) && (nTab == meta::beat_breather::TAB_BEAT_PROCESSOR) && (b->nSync & SYNC_BEAT_CURVE))
+                    {
+                        gate_curve(b->vBpMesh, &b->sBp, vBpMesh, SYNC_BEAT_PROC,
+                            bp_th, bp_zone, bp_reduction, b->fBpMakeup);
+                        b->nSync                = (b->nSync & (~SYNC_BEAT_CURVE)) | SYNC_BEAT_PROC;
                     }
 
-                    b->sBpScDelay.set_delay(bp_sc_latency);
-                    b->sBpDelay.set_delay(pd_latency + pf_latency + bp_latency);
+                    b->nBpDelay             = pd_latency + pf_latency + bp_latency;
+
+                    // Update the envelopes of the spectral gain mode
+                    configure_band_spectral(b, spc_frame_rate);
 
                     // Compute the overall latency of the band
                     if (b->nMode != BAND_OFF)
-                        max_band_latency        = lsp_max(max_band_latency, b->sBpDelay.delay());
+                        max_band_latency        = lsp_max(max_band_latency, b->nBpDelay);
                 }
 
                 // Reconfigure the crossover
                 bool csync   = (sync) || (c->sCrossover.needs_update());
                 c->sCrossover.update_settings();
+                if (c->sSpectral.needs_update())
+                    c->sSpectral.update_settings();
 
                 if ((csync) && (i == 0))
                 {
-                    // Output band parameters and update sync curve flag
-                    for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
-                    {
-                        band_t *b               = &c->vBands[j];
-
-                        // Get frequency response for band
-                        c->sCrossover.freq_chart(j, b->vFreqChart, vFftFreqs, meta::beat_breather::FFT_MESH_POINTS);
-                        b->nSync               |= SYNC_BAND_FILTER;
-                    }
+                    update_freq_charts();
+                    xsync                   = true;
                 }
             }
 
-            // Apply latency compensations and report latency
-            for (size_t i=0; i<nChannels; ++i)
+            nMaxBandLatency         = max_band_latency;
+
+            // Select the processing engine, band filters alone are applied as one static filter in any mode
+            bool dynamic            = false;
+            for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
             {
-                channel_t *c        = &vChannels[i];
+                const band_mode_t mode  = vChannels[0].vBands[j].nMode;
+                if ((band_mixed(mode)) && (mode != BAND_BF))
+                    dynamic                 = true;
+            }
+            const engine_t engine   = (!dynamic) ? ENGINE_STATIC : (bSpectral) ? ENGINE_SPECTRAL : ENGINE_CROSSOVER;
+            const bool esync        = engine != nEngine;
+            // The static and the spectral engines share the spectral processor and the band envelopes
+            const bool psync        = (engine == ENGINE_CROSSOVER) != (nEngine == ENGINE_CROSSOVER);
+            nEngine                 = engine;
+
+            // Start the processor being switched to with the clean state, the delayed input fills the gap in its output
+            for (size_t i=0; (psync) && (i<nChannels); ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                if (nEngine != ENGINE_CROSSOVER)
+                    c->sSpectral.clear();
+                else
+                    c->sCrossover.clear();
+                restart_engine(c);
+
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *b               = &c->vBands[j];
-                    if (b->nMode == BAND_OFF)
-                        continue;
-                    b->sDelay.set_delay(max_band_latency - b->sBpDelay.delay());
-
-                    lsp_trace("Band #%d: latency=%d, compensation=%d, overall=%d",
-                        int(i),
-                        int(b->sBpDelay.delay()),
-                        int(b->sDelay.delay()),
-                        int(max_band_latency));
+                    b->fSpcLong             = 0.0f;
+                    b->fSpcShort            = 0.0f;
+                    b->fSpcPfEnv            = 0.0f;
+                    b->fSpcBpEnv            = 0.0f;
                 }
-
-                size_t overall_latency  = max_band_latency + c->sCrossover.latency();
-                c->sDelay.set_delay(overall_latency);
-                c->sDryDelay.set_delay(overall_latency);
-
-                if (i == 0)
-                    set_latency(overall_latency);
             }
+            // Early band estimates are computed from the input history and need only the filters to be reset
+            for (size_t i=0; (early_sync) && (i<nChannels); ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b               = &c->vBands[j];
+                    b->sEarlyHpf.clear();
+                    b->sEarlyLpf.clear();
+                }
+            }
+            // Band masks are sampled only when the crossover has changed since they were used last time
+            if (xsync)
+                bSpcSync                = true;
+            if ((nEngine != ENGINE_CROSSOVER) && (bSpcSync))
+                update_spectral_masks();
+            if (nEngine == ENGINE_STATIC)
+                update_static_gain();
+
+            update_band_activity();
+            rebuild_gate_banks();
+            update_latency();
         }
 
-        void beat_breather::process_band(void *object, void *subject, size_t band, const float *data, size_t sample, size_t count)
-        {
-            channel_t *c            = static_cast<channel_t *>(subject);
-            band_t *b               = &c->vBands[band];
-
-            // Apply delay compensation and store to band's data buffer.
-            b->sDelay.process(&b->vInData[sample], data, count);
-            // Measure the input level
-            b->fInLevel             = lsp_max(dsp::abs_max(&b->vInData[sample], count), b->fInLevel);
-        }
-
-        void beat_breather::process(size_t samples)
+        void beat_breather::configure_band_control(band_t *b, size_t slot, bool migrate)
         {
-            bind_inputs();
-
-            for (size_t offset = 0; offset < samples; )
+            const size_t rate       = b->nCtlRate;
+            const size_t group      = int_log2(rate);
+            const size_t old_rate   = size_t(1) << b->nCtlGroup;
+            const bool moved        = (migrate) && (group != b->nCtlGroup);
+            const bool active       = band_active(b);
+            const float ctl_time    = 1.0f / float(rate);
+
+            // Envelopes follow the band to the bank of the new control rate
+            if (!migrate)
             {
-                size_t to_do        = lsp_min(samples - offset, BUFFER_SIZE);
-
-                // Stores band data to band_t::vIn
-                split_signal(to_do);
-                // Stores normalized RMS difference to band_t::vPdData
-                apply_peak_detector(to_do);
-                // Stores processed data to band_t::vPfData
-                apply_punch_filter(to_do);
-                // Stores the processed band data to band_t::vBpData
-                apply_beat_processor(to_do);
-
-                // Stores the processed band data to channel_t::vOutData
-                mix_bands(to_do);
-
-                // Post-process data
-                post_process_block(to_do);
+                vPfBanks[group].vSlotEnv[slot]  = 0.0f;
+                vBpBanks[group].vSlotEnv[slot]  = 0.0f;
+            }
+            else if (moved)
+            {
+                move_gate_slot(&vPfBanks[group], &vPfBanks[b->nCtlGroup], slot);
+                move_gate_slot(&vBpBanks[group], &vBpBanks[b->nCtlGroup], slot);
+            }
 
-                // Update pointers and the offset
-                update_pointers(to_do);
-                offset             += to_do;
+            // Long-time and short-time RMS estimation, the moved lane continues from the mean squares of the old one
+            const float pd_long     = b->pPdLongTime->value();
+            const float pd_short    = b->pPdShortTime->value();
+            const float pd_bias     = dspu::db_to_gain(b->pPdBias->value());
+            for (size_t k=0; k<CTL_GROUPS; ++k)
+                set_rms_lane(
+                    &vRmsBanks[k], slot,
+                    ((!active) || (k != group)) ? NULL : (rate > 1) ? b->vBpData : b->vInData,
+                    b->vPdData, b->vPfData,
+                    dspu::millis_to_samples(fSampleRate, pd_long * ctl_time),
+                    dspu::millis_to_samples(fSampleRate, pd_short * ctl_time),
+                    pd_bias);
+            if ((moved) && (active))
+                move_rms_lane(&vRmsBanks[group], &vRmsBanks[b->nCtlGroup], slot);
+
+            // Delays of the control signals are measured in samples of the control rate
+            const size_t pd_short_latency   = dspu::millis_to_samples(fSampleRate, pd_long - pd_short) / 2;
+            const size_t pf_latency         = dspu::millis_to_samples(fSampleRate, b->pPfLookahead->value());
+            const size_t bp_sc_latency      = dspu::millis_to_samples(fSampleRate, lsp_max(b->pBpTimeShift->value(), 0.0f));
+            b->nPdDelay             = pd_short_latency / rate;
+            b->nPfDelay             = pf_latency / rate;
+            b->nBpScDelay           = bp_sc_latency / rate;
+            if (moved)
+            {
+                remap_ring(&b->sPdRing, b->nPdDelay, old_rate, rate);
+                remap_ring(&b->sPfRing, b->nPfDelay, old_rate, rate);
+                remap_ring(&b->sBpScRing, b->nBpScDelay, old_rate, rate);
             }
 
-            sCounter.submit(samples);
+            b->sPf.set_attack(b->pPfAttack->value() * ctl_time);
+            b->sPf.set_release(b->pPfRelease->value() * ctl_time);
+            b->sBp.set_attack(b->pBpAttack->value() * ctl_time);
+            b->sBp.set_release(b->pBpRelease->value() * ctl_time);
 
-            output_meters();
+            b->nCtlGroup            = group;
+        }
 
-            if ((pWrapper != NULL) && (sCounter.fired()))
-                pWrapper->query_display_draw();
-            sCounter.commit();
+        void beat_breather::configure_band_spectral(band_t *b, float frame_rate)
+        {
+            // The envelopes of the spectral gain mode advance once per frame of the spectral processor
+            const float pd_bias     = dspu::db_to_gain(b->pPdBias->value());
+            b->fSpcLongTau          = gate_tau(frame_rate, b->pPdLongTime->value() * 0.5f);
+            b->fSpcShortTau         = gate_tau(frame_rate, b->pPdShortTime->value() * 0.5f);
+            b->fSpcBias             = pd_bias * pd_bias;
+            b->fSpcPfAttack         = gate_tau(frame_rate, b->pPfAttack->value());
+            b->fSpcPfRelease        = gate_tau(frame_rate, b->pPfRelease->value());
+            b->fSpcBpAttack         = gate_tau(frame_rate, b->pBpAttack->value());
+            b->fSpcBpRelease        = gate_tau(frame_rate, b->pBpRelease->value());
         }
 
-        void beat_breather::bind_inputs()
+        void beat_breather::rebuild_gate_banks()
         {
+            // Rebuild the batched envelope followers of punch filters and beat processors
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+            {
+                reset_gate_bank(&vPfBanks[i]);
+                reset_gate_bank(&vBpBanks[i]);
+            }
             for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c        = &vChannels[i];
-                c->vIn              = c->pIn->buffer<float>();
-                c->vOut             = c->pOut->buffer<float>();
-
-                c->fInLevel         = GAIN_AMP_M_INF_DB;
-                c->fOutLevel        = GAIN_AMP_M_INF_DB;
-
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
-                    band_t *b           = &c->vBands[j];
-
-                    b->fInLevel         = GAIN_AMP_M_INF_DB;
-                    b->fOutLevel        = GAIN_AMP_M_INF_DB;
-
-                    b->fPdLevel         = GAIN_AMP_M_INF_DB;
-
-                    b->fPfInGain        = GAIN_AMP_M_INF_DB;
-                    b->fPfOutGain       = GAIN_AMP_M_INF_DB;
-                    b->fPfReduction     = GAIN_AMP_0_DB;
+                    band_t *b               = &c->vBands[j];
+                    if (!band_active(b))
+                        continue;
 
-                    b->fBpInGain        = GAIN_AMP_M_INF_DB;
-                    b->fBpOutGain       = GAIN_AMP_M_INF_DB;
-                    b->fBpReduction     = GAIN_AMP_M_INF_DB;
+                    const size_t slot       = i * meta::beat_breather::BANDS_MAX + j;
+                    const float ctl_time    = 1.0f / float(b->nCtlRate);
+                    add_gate(&vPfBanks[b->nCtlGroup], slot, b->vPdData, b->vPfData,
+                        gate_tau(fSampleRate, b->pPfAttack->value() * ctl_time),
+                        gate_tau(fSampleRate, b->pPfRelease->value() * ctl_time));
+                    add_gate(&vBpBanks[b->nCtlGroup], slot, b->vBpData, b->vBpData,
+                        gate_tau(fSampleRate, b->pBpAttack->value() * ctl_time),
+                        gate_tau(fSampleRate, b->pBpRelease->value() * ctl_time));
                 }
             }
         }
 
-        void beat_breather::split_signal(size_t samples)
+        bool beat_breather::update_band_activity()
         {
+            const bool meters       = (bUIActive) && (nOvlTier < meta::beat_breather::OVL_METERS);
+            bool changed            = false;
+            bIdleSync               = false;
+
             for (size_t i=0; i<nChannels; ++i)
             {
-                channel_t *c        = &vChannels[i];
+                channel_t *c            = &vChannels[i];
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b               = &c->vBands[j];
+                    if (b->nMode == BAND_OFF)
+                        continue;
 
-                // Apply gain to input signal
-                dsp::mul_k3(c->vInData, c->vIn, fInGain, samples);
-                // Pass the input signal to crossover
-                c->sCrossover.process(c->vInData, samples);
+                    // The silent band becomes idle when its mute ramp reaches zero, other engines do not mix the bands.
+                    // The band with -inf dB gain is silent too unless its meters are visible
+                    b->bSilent              = (b->nMode == BAND_MUTE) ||
+                                              ((b->fGain <= meta::beat_breather::BAND_GAIN_MIN) && (!meters));
+                    if ((b->bSilent) && (nEngine != ENGINE_CROSSOVER))
+                        b->fMute                = 0.0f;
+                    const bool idle         = (b->bSilent) && (b->fMute <= 0.0f);
+                    if (idle == b->bIdle)
+                        continue;
+
+                    // The woken band starts from silence and fades in when its crossover band and
+                    // envelopes have been refilled, which takes the latency of the band processing
+                    b->bIdle                = idle;
+                    b->nWarmup              = (idle) ? 0 : c->sCrossover.latency() + nMaxBandLatency;
+                    c->sCrossover.enable_band(j, !idle);
+                    configure_band_control(b, i * meta::beat_breather::BANDS_MAX + j, true);
+                    changed                 = true;
+                }
             }
+
+            return changed;
         }
 
-        void beat_breather::normalize_rms(float *dst, const float *lrms, const float *srms, float gain, size_t samples)
+        void beat_breather::update_latency()
         {
-            for (size_t i=0; i<samples; ++i)
-            {
-                const float l       = lrms[i];
+            // The static engine replacing the crossover engine keeps the latency of the crossover engine,
+            // so switching the band modes between the band filter and other modes does not change the latency
+            const bool xover_ref    = (nEngine == ENGINE_CROSSOVER) || (!bSpectral);
+            const bool early_det    = (bEarly) && (xover_ref);
+
+            // Apply latency compensations and report latency
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                // The early band estimate runs ahead of the crossover output by the crossover latency,
+                // so the latency of the detection overlaps the crossover latency instead of adding to it.
+                // The IIR estimate itself lags by its group delay, which is compensated by a shorter early delay
+                const size_t xover_delay    = c->sCrossover.latency();
+                size_t xover_latency        = nMaxBandLatency + xover_delay;
+                if (early_det)
+                {
+                    xover_latency               = xover_delay;
+                    for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                    {
+                        const band_t *b             = &c->vBands[j];
+                        if (b->nMode != BAND_OFF)
+                            xover_latency               = lsp_max(xover_latency, b->nBpDelay + lsp_min(b->nEarlyGd, xover_delay));
+                    }
+                }
+
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b               = &c->vBands[j];
+                    if (b->nMode == BAND_OFF)
+                        continue;
+                    b->nCompDelay           = nMaxBandLatency - b->nBpDelay;
+                    b->nOutDelay            = xover_latency - xover_delay;
+                    b->nEarlyDelay          = (early_det) ? xover_latency - b->nBpDelay - lsp_min(b->nEarlyGd, xover_delay) : 0;
+
+                    lsp_trace("Band #%d: latency=%d, compensation=%d, early=%d, overall=%d",
+                        int(i),
+                        int(b->nBpDelay),
+                        int(b->nCompDelay),
+                        int(b->nEarlyDelay),
+                        int(xover_latency));
+                }
+
+                const size_t engine_latency = (nEngine == ENGINE_CROSSOVER) ? xover_latency : c->sSpectral.latency();
+                size_t overall_latency  = (xover_ref) ? lsp_max(xover_latency, engine_latency) : engine_latency;
+
+                // Pad the output up to the maximum possible latency so the host never has to rebuild the delay compensation
+                if ((bLatencyLock) && (nLockLatency > overall_latency))
+                    overall_latency         = nLockLatency;
+                c->nPadDelay            = overall_latency - engine_latency;
+                c->nDelay               = overall_latency;
+
+                if (i == 0)
+                    set_latency(overall_latency);
+            }
+        }
+
+        void beat_breather::process_band(void * /* object */, void *subject, size_t band, const float *data, size_t /* sample */, size_t count)
+        {
+            channel_t *c            = static_cast<channel_t *>(subject);
+
+            // Only collect the band signal, latency compensation is applied by split_signal() for the whole block
+            ring_push(&c->vBands[band].sRing, data, count);
+        }
+
+        void beat_breather::process_spectrum(void *object, void *subject, float *spectrum, size_t rank)
+        {
+            beat_breather *self     = static_cast<beat_breather *>(object);
+            channel_t *c            = static_cast<channel_t *>(subject);
+
+            self->apply_spectral_gain(c, spectrum, rank);
+        }
+
+        void beat_breather::update_spectral_masks()
+        {
+            channel_t *c            = &vChannels[0];
+            const size_t size       = size_t(1) << c->sSpectral.get_rank();
+            const size_t bins       = (size >> 1) + 1;
+            if ((vSpcMask == NULL) || (bins > nSpcBins))
+                return;
+
+            // The gain buffer temporarily holds frequencies of the bins
+            const float kf          = fSampleRate / float(size);
+            for (size_t k=0; k<bins; ++k)
+                vSpcGain[k]             = kf * k;
+
+            // Sample the magnitude response of each band at the bins directly into the mask, masks of all bands
+            // are sampled since the mode of the band may change without changing the crossover
+            for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                c->sCrossover.freq_chart(j, &vSpcMask[j * nSpcBins], vSpcGain, bins);
+            bSpcSync                = false;
+        }
+
+        void beat_breather::apply_spectral_gain(channel_t *c, float *spectrum, size_t rank)
+        {
+            const size_t size       = size_t(1) << rank;
+            const size_t bins       = (size >> 1) + 1;
+            if ((vSpcMask == NULL) || (bins > nSpcBins))
+                return;
+
+            const bool meters       = nOvlTier < meta::beat_breather::OVL_METERS;
+            const bool fixed        = nEngine == ENGINE_STATIC;
+            const float norm        = 2.0f / float(size);
+
+            // The static engine has the per-bin gain computed, the energy of bands is needed only for the meters
+            if ((fixed) && (!meters))
+            {
+                apply_bin_gain(spectrum, vSpcGain, rank);
+                return;
+            }
+
+            // Compute the power spectrum of the frame once for all bands
+            for (size_t k=0; k<bins; ++k)
+            {
+                const float re          = spectrum[k*2];
+                const float im          = spectrum[k*2 + 1];
+                vSpcPower[k]            = re*re + im*im;
+            }
+
+            // Estimate the energy of each band and compute its gain, the envelopes advance once per frame
+            float gain[meta::beat_breather::BANDS_MAX];
+            for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+            {
+                band_t *b               = &c->vBands[j];
+                gain[j]                 = 0.0f;
+                if (!band_processed(b->nMode))
+                    continue;
+
+                const float *mask       = &vSpcMask[j * nSpcBins];
+                float energy            = 0.0f;
+                for (size_t k=0; k<bins; ++k)
+                    energy                 += mask[k] * mask[k] * vSpcPower[k];
+
+                // The static engine only outputs the band filters, the envelopes are held until the switch back
+                if (fixed)
+                {
+                    const float level       = sqrtf(energy) * norm;
+                    b->fInLevel             = lsp_max(level, b->fInLevel);
+                    b->fOutLevel            = lsp_max(level * ((b->nMode == BAND_MUTE) ? 0.0f : b->fGain), b->fOutLevel);
+                    b->fReduction           = b->fGain;
+                    continue;
+                }
+
+                // Punch detector
+                b->fSpcLong            += (energy - b->fSpcLong) * b->fSpcLongTau;
+                b->fSpcShort           += (energy * b->fSpcBias - b->fSpcShort) * b->fSpcShortTau;
+                const float lrms        = sqrtf(lsp_max(b->fSpcLong, 0.0f));
+                const float srms        = sqrtf(lsp_max(b->fSpcShort, 0.0f));
+                float pd;
+                normalize_rms(&pd, &lrms, &srms, b->fPdMakeup, 1);
+
+                // Punch filter
+                float d                 = pd - b->fSpcPfEnv;
+                b->fSpcPfEnv           += ((d > 0.0f) ? b->fSpcPfAttack : b->fSpcPfRelease) * d;
+                const float pf_vca      = b->sPf.amplification(b->fSpcPfEnv);
+                const float pf          = pd * pf_vca;
+
+                // Beat processor
+                d                       = pf - b->fSpcBpEnv;
+                b->fSpcBpEnv           += ((d > 0.0f) ? b->fSpcBpAttack : b->fSpcBpRelease) * d;
+                const float bp_vca      = b->sBp.amplification(b->fSpcBpEnv) * b->fBpMakeup;
+
+                // Only the beat processor output is an audio signal, other listen modes pass the band as is,
+                // the muted band keeps its envelopes running, the overlap-add of frames smooths the gain change
+                gain[j]                 = (b->nMode == BAND_BP) ? b->fGain * bp_vca :
+                                          (b->nMode == BAND_MUTE) ? 0.0f : b->fGain;
+
+                if (meters)
+                {
+                    const float level       = sqrtf(energy) * norm;
+                    b->fInLevel             = lsp_max(level, b->fInLevel);
+                    b->fOutLevel            = lsp_max(level * gain[j], b->fOutLevel);
+                    b->fPdLevel             = lsp_max(pd, b->fPdLevel);
+                    if (b->fSpcPfEnv > b->fPfInGain)
+                    {
+                        b->fPfInGain            = b->fSpcPfEnv;
+                        b->fPfOutGain           = pf_vca * b->fSpcPfEnv;
+                    }
+                    b->fPfReduction         = lsp_min(pf_vca, b->fPfReduction);
+                    if (b->fSpcBpEnv > b->fBpInGain)
+                    {
+                        b->fBpInGain            = b->fSpcBpEnv;
+                        b->fBpOutGain           = bp_vca * b->fSpcBpEnv;
+                    }
+                    b->fBpReduction         = lsp_max(bp_vca, b->fBpReduction);
+                    b->fReduction           = (b->nMode == BAND_BP) ? b->fBpReduction * b->fGain : b->fGain;
+                }
+            }
+
+            // Form the per-bin gain as the sum of band responses weighted by band gains, the static engine has it computed
+            if (!fixed)
+            {
+                dsp::fill_zero(vSpcGain, bins);
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    if (gain[j] != 0.0f)
+                        dsp::fmadd_k3(vSpcGain, &vSpcMask[j * nSpcBins], gain[j], bins);
+                }
+            }
+
+            apply_bin_gain(spectrum, vSpcGain, rank);
+        }
+
+        void beat_breather::apply_bin_gain(float *spectrum, const float *gain, size_t rank)
+        {
+            const size_t size       = size_t(1) << rank;
+            const size_t bins       = (size >> 1) + 1;
+
+            // Apply the gain to positive frequencies and to mirrored negative frequencies
+            for (size_t k=0; k<bins; ++k)
+            {
+                spectrum[k*2]          *= gain[k];
+                spectrum[k*2 + 1]      *= gain[k];
+            }
+            for (size_t k=1; k<bins-1; ++k)
+            {
+                float *s                = &spectrum[(size - k)*2];
+                s[0]                   *= gain[k];
+                s[1]                   *= gain[k];
+            }
+        }
+
+        void beat_breather::update_static_gain()
+        {
+            const channel_t *c      = &vChannels[0];
+            const size_t bins       = ((size_t(1) << c->sSpectral.get_rank()) >> 1) + 1;
+            if ((vSpcMask == NULL) || (bins > nSpcBins))
+                return;
+
+            // The combined response of all band filters, the gains are the same for all channels
+            dsp::fill_zero(vSpcGain, bins);
+            for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+            {
+                const band_t *b         = &c->vBands[j];
+                if (band_mixed(b->nMode))
+                    dsp::fmadd_k3(vSpcGain, &vSpcMask[j * nSpcBins], b->fGain, bins);
+            }
+        }
+
+        void beat_breather::process(size_t samples)
+        {
+            system::time_t ts_start;
+            if (bOvlGuard)
+                system::get_time(&ts_start);
+
+            bind_inputs();
+            // Bands which have faded out after mute leave the processing
+            if ((bIdleSync) && (update_band_activity()))
+                rebuild_gate_banks();
+
+            // Dispatch the processing to the specialization for the channel layout
+            if (nChannels < 2)
+                process_blocks<1, false>(samples);
+            else if (bStereoSplit)
+                process_blocks<2, false>(samples);
+            else
+                process_blocks<2, true>(samples);
+
+            sCounter.submit(samples);
+
+            output_meters();
+
+            // Pass the collected data to the analyzer worker
+            submit_analyzer();
+
+            if ((pWrapper != NULL) && (sCounter.fired()))
+                pWrapper->query_display_draw();
+            sCounter.commit();
+
+            // Estimate the processing load and apply the overload degradation
+            if (bOvlGuard)
+            {
+                system::time_t ts_end;
+                system::get_time(&ts_end);
+
+                const float elapsed = float(wssize_t(ts_end.seconds) - wssize_t(ts_start.seconds)) +
+                                      float(wssize_t(ts_end.nanos) - wssize_t(ts_start.nanos)) * 1e-9f;
+                const size_t old_tier   = nOvlTier;
+                if (update_overload(elapsed, samples))
+                    apply_overload_tier(old_tier);
+            }
+        }
+
+        size_t beat_breather::crossover_rank(split_t * const *splits, size_t nsplits) const
+        {
+            const size_t quality    = size_t(pXoverQuality->value());
+            size_t rank             = nFftRank;
+
+            if (quality == meta::beat_breather::XOVER_HIGH)
+                rank                    = nFftRank + 1;
+            else if ((quality == meta::beat_breather::XOVER_ECONOMY) && (nFftRank > meta::beat_breather::FFT_XOVER_RANK_ECONOMY))
+            {
+                // Find the steepest slope of the filters of active bands
+                const channel_t *c      = &vChannels[0];
+                float slope             = 0.0f;
+                for (size_t j=0; j<=nsplits; ++j)
+                {
+                    const band_t *b         = &c->vBands[(j > 0) ? splits[j-1]->nBandId : 0];
+                    if (j > 0)
+                        slope                   = lsp_max(slope, b->pHpfSlope->value());
+                    if (j < nsplits)
+                        slope                   = lsp_max(slope, b->pLpfSlope->value());
+                }
+
+                // Select the minimal rank which resolves the octave below the lowest split with enough bins
+                const float bins        = lsp_max(meta::beat_breather::FFT_XOVER_ECONOMY_BINS, slope / meta::beat_breather::FFT_XOVER_ECONOMY_SLOPE);
+                const float items       = (nsplits > 0) ? 2.0f * bins * fSampleRate / splits[0]->fFrequency : 0.0f;
+
+                rank                    = meta::beat_breather::FFT_XOVER_RANK_ECONOMY;
+                while ((rank < nFftRank) && (float(1 << rank) < items))
+                    ++rank;
+            }
+
+            return rank;
+        }
+
+        size_t beat_breather::overload_rank(size_t rank) const
+        {
+            // Lower the precision of the crossover on overload
+            if ((nOvlTier >= meta::beat_breather::OVL_CROSSOVER) && (rank > meta::beat_breather::FFT_XOVER_RANK_ECONOMY))
+                --rank;
+
+            return rank;
+        }
+
+        bool beat_breather::analyzer_busy() const
+        {
+            return !((sAnTask.idle()) || (sAnTask.completed()));
+        }
+
+        void beat_breather::wait_analyzer()
+        {
+            while (analyzer_busy())
+                ipc::Thread::sleep(1);
+        }
+
+        bool beat_breather::configure_analyzer()
+        {
+            size_t an_channels  = 0;
+
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c    = &vChannels[i];
+
+                // Update analyzer settings
+                sAnalyzer.enable_channel(c->nAnIn, c->pInFft->value() >= 0.5f);
+                sAnalyzer.enable_channel(c->nAnOut, c->pOutFft->value() >= 0.5f);
+
+                if (sAnalyzer.channel_active(c->nAnIn))
+                    an_channels ++;
+                if (sAnalyzer.channel_active(c->nAnOut))
+                    an_channels ++;
+            }
+
+            // Update analyzer parameters
+            sAnalyzer.set_reactivity(pFFTReactivity->value());
+            if (pFFTShift != NULL)
+                sAnalyzer.set_shift(dspu::db_to_gain(pFFTShift->value()) * 100.0f);
+            sAnalyzer.set_activity((an_channels > 0) && (nOvlTier < meta::beat_breather::OVL_ANALYZER));
+
+            if (!sAnalyzer.needs_reconfiguration())
+                return false;
+
+            // Reconfiguration recomputes the FFT windows and is too heavy for the audio thread, it is performed
+            // by the worker launched by submit_analyzer(). Without the worker the analyzer is reconfigured in place
+            if (pExecutor != NULL)
+            {
+                bAnReconfig         = true;
+                return false;
+            }
+
+            reconfigure_analyzer();
+            return commit_analyzer();
+        }
+
+        void beat_breather::reconfigure_analyzer()
+        {
+            sAnalyzer.reconfigure();
+            sAnalyzer.get_frequencies(
+                vAnFreqs,
+                vAnIndexes,
+                SPEC_FREQ_MIN,
+                SPEC_FREQ_MAX,
+                meta::beat_breather::FFT_MESH_POINTS);
+
+            bAnReconfig         = false;
+            bAnFreqs            = true;
+        }
+
+        bool beat_breather::commit_analyzer()
+        {
+            if (!bAnFreqs)
+                return false;
+
+            // The worker is idle, the frequencies are not accessed by it anymore
+            dsp::copy(vFftFreqs, vAnFreqs, meta::beat_breather::FFT_MESH_POINTS);
+            memcpy(vFftIndexes, vAnIndexes, sizeof(uint32_t) * meta::beat_breather::FFT_MESH_POINTS);
+            bAnFreqs            = false;
+            return true;
+        }
+
+        void beat_breather::update_freq_charts()
+        {
+            // Output band parameters of the first channel and update sync curve flag
+            channel_t *c            = &vChannels[0];
+            for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+            {
+                band_t *b               = &c->vBands[j];
+
+                // Get frequency response for band
+                c->sCrossover.freq_chart(j, b->vFreqChart, vFftFreqs, meta::beat_breather::FFT_MESH_POINTS);
+                b->nSync               |= SYNC_BAND_FILTER;
+            }
+        }
+
+        size_t beat_breather::halfband_decimate(halfband_t *hb, const float *fir, float *buf, size_t samples)
+        {
+            constexpr size_t taps   = HALFBAND_TAPS;
+            constexpr size_t odd    = HALFBAND_ODD;
+            constexpr size_t center = odd * 2 - 1;
+            size_t head         = hb->nHead;
+            size_t phase        = hb->nPhase;
+            size_t count        = 0;
+
+            for (size_t i=0; i<samples; ++i)
+            {
+                head                = (head > 0) ? head - 1 : taps - 1;
+                hb->vDelay[head]    = buf[i];
+                hb->vDelay[head + taps] = buf[i];
+                if ((phase ^= 1) != 0)
+                    continue;
+
+                // Only odd taps around the center are non-zero, the filter is symmetric
+                const float *w      = &hb->vDelay[head + center];
+                float s             = 0.5f * w[0];
+                for (size_t k=0; k<odd; ++k)
+                    s                  += fir[k] * (w[-ptrdiff_t(k * 2 + 1)] + w[k * 2 + 1]);
+                buf[count++]        = s;
+            }
+
+            hb->nHead           = head;
+            hb->nPhase          = phase;
+            return count;
+        }
+
+        size_t beat_breather::decimate_analyzer(size_t samples)
+        {
+            // Decimate by 2 in place with the cascade of half-band filters, each stage keeps the band up to 20 kHz flat
+            // and rejects the frequencies which alias into the audible range
+            size_t count            = samples;
+            for (size_t i=0; i<nChannels*2; ++i)
+            {
+                count                   = samples;
+                for (size_t j=0; j<nAnStages; ++j)
+                    count                   = halfband_decimate(&vAnStages[i][j], vAnFir, vAnalyze[i], count);
+            }
+
+            return count;
+        }
+
+        void beat_breather::push_analyzer(size_t samples)
+        {
+            // Reduce the sample rate of the analyzer input
+            samples                 = decimate_analyzer(samples);
+            if (samples == 0)
+                return;
+
+            // Drop the data if the worker does not keep up with the audio thread
+            const uatomic_t head    = nAnHead;
+            const uatomic_t tail    = atomic_load(&nAnTail);
+            if (ANALYZER_RING_SIZE - uatomic_t(head - tail) < samples)
+                return;
+
+            const size_t offset     = head & (ANALYZER_RING_SIZE - 1);
+            const size_t part       = lsp_min(samples, ANALYZER_RING_SIZE - offset);
+            for (size_t i=0; i<nChannels*2; ++i)
+            {
+                dsp::copy(&vAnRing[i][offset], vAnalyze[i], part);
+                if (part < samples)
+                    dsp::copy(vAnRing[i], &vAnalyze[i][part], samples - part);
+            }
+
+            atomic_store(&nAnHead, uatomic_t(head + samples));
+        }
+
+        void beat_breather::submit_analyzer()
+        {
+            if (sAnTask.completed())
+                sAnTask.reset();
+            if (!sAnTask.idle())
+                return;
+
+            // The worker is idle, commit the result of reconfiguration and apply deferred settings
+            bool sync           = commit_analyzer();
+            if (bAnSync)
+            {
+                bAnSync             = false;
+                sync                = (configure_analyzer()) || (sync);
+            }
+            if (sync)
+                update_freq_charts();
+
+            // Launch the worker if there is pending data or reconfiguration
+            if ((pExecutor != NULL) && ((bAnReconfig) || (atomic_load(&nAnTail) != nAnHead)))
+                pExecutor->submit(&sAnTask);
+        }
+
+        void beat_breather::process_analyzer()
+        {
+            // Apply the settings passed by the audio thread before processing the data
+            if (bAnReconfig)
+                reconfigure_analyzer();
+
+            const uatomic_t head    = atomic_load(&nAnHead);
+            uatomic_t tail          = nAnTail;
+
+            while (tail != head)
+            {
+                const size_t offset     = tail & (ANALYZER_RING_SIZE - 1);
+                const size_t to_do      = lsp_min(size_t(uatomic_t(head - tail)), ANALYZER_RING_SIZE - offset);
+                for (size_t i=0; i<nChannels*2; ++i)
+                    vAnData[i]              = &vAnRing[i][offset];
+
+                sAnalyzer.process(vAnData, to_do);
+
+                tail                   += to_do;
+                atomic_store(&nAnTail, tail);
+            }
+        }
+
+        template <size_t CHANNELS, bool LINKED>
+        void beat_breather::process_blocks(size_t samples)
+        {
+            for (size_t offset = 0; offset < samples; )
+            {
+                size_t to_do        = lsp_min(samples - offset, BUFFER_SIZE);
+
+                if (nEngine != ENGINE_CROSSOVER)
+                {
+                    // Stores the processed channel data to channel_t::vOutData
+                    process_spectral<CHANNELS>(to_do);
+                }
+                else
+                {
+                    // Stores band data to band_t::vIn
+                    split_signal<CHANNELS>(to_do);
+                    // Stores normalized RMS difference to band_t::vPdData
+                    apply_peak_detector<CHANNELS, LINKED>(to_do);
+                    // Stores processed data to band_t::vPfData
+                    apply_punch_filter<CHANNELS>(to_do);
+                    // Stores the beat processor VCA to band_t::vBpData
+                    apply_beat_processor<CHANNELS>(to_do);
+
+                    // Stores the processed band data to channel_t::vOutData
+                    mix_bands<CHANNELS>(to_do);
+                }
+
+                // Post-process data
+                post_process_block<CHANNELS>(to_do);
+
+                // Update pointers and the offset
+                update_pointers<CHANNELS>(to_do);
+                offset             += to_do;
+            }
+        }
+
+        bool beat_breather::update_overload(float elapsed, size_t samples)
+        {
+            // Estimate the processing load relative to the block deadline
+            const float deadline    = float(samples) / fSampleRate;
+            const float load        = (elapsed > 0.0f) ? elapsed / deadline : 0.0f;
+            const float react       = dspu::seconds_to_samples(fSampleRate, meta::beat_breather::OVL_REACT_TIME);
+            fOvlLoad               += (load - fOvlLoad) * (float(samples) / (float(samples) + react));
+
+            // Step down on sustained overload, step up on sustained safe load
+            if (fOvlLoad >= meta::beat_breather::OVL_LOAD_HIGH)
+            {
+                nOvlLow                 = 0;
+                nOvlHigh               += samples;
+                if (nOvlHigh < dspu::seconds_to_samples(fSampleRate, meta::beat_breather::OVL_DEGRADE_TIME))
+                    return false;
+                nOvlHigh                = 0;
+                // The crossover tier changes the latency, so it is only allowed while the latency is locked
+                const size_t max_tier   = (bLatencyLock) ? meta::beat_breather::OVL_CROSSOVER : meta::beat_breather::OVL_ENVELOPE;
+                if (nOvlTier >= max_tier)
+                    return false;
+
+                ++nOvlTier;
+                if (nOvlBackoff < meta::beat_breather::OVL_BACKOFF_MAX)
+                    ++nOvlBackoff;
+            }
+            else if (fOvlLoad <= meta::beat_breather::OVL_LOAD_LOW)
+            {
+                nOvlHigh                = 0;
+                nOvlLow                += samples;
+                if (nOvlLow < dspu::seconds_to_samples(fSampleRate, meta::beat_breather::OVL_RECOVER_TIME * (1 << nOvlBackoff)))
+                    return false;
+                nOvlLow                 = 0;
+                if (nOvlTier <= meta::beat_breather::OVL_NONE)
+                {
+                    nOvlBackoff             = 0;
+                    return false;
+                }
+
+                --nOvlTier;
+            }
+            else
+            {
+                nOvlHigh                = 0;
+                nOvlLow                 = 0;
+                return false;
+            }
+
+            lsp_trace("Overload tier changed: tier=%d, load=%.3f", int(nOvlTier), fOvlLoad);
+            return true;
+        }
+
+        void beat_breather::apply_overload_tier(size_t old_tier)
+        {
+            // Only the stage crossed by the tier change is reconfigured, meters are just frozen by bind_inputs()
+            if ((old_tier < meta::beat_breather::OVL_ANALYZER) != (nOvlTier < meta::beat_breather::OVL_ANALYZER))
+            {
+                bAnSync             = analyzer_busy();
+                if ((!bAnSync) && (configure_analyzer()))
+                    update_freq_charts();
+            }
+            if ((old_tier < meta::beat_breather::OVL_ENVELOPE) != (nOvlTier < meta::beat_breather::OVL_ENVELOPE))
+                update_control_rate();
+            if ((old_tier < meta::beat_breather::OVL_CROSSOVER) != (nOvlTier < meta::beat_breather::OVL_CROSSOVER))
+                update_crossover_rank();
+            // The frequency charts are refreshed when the meters are unfrozen, the crossover rank may have changed.
+            // Bands with -inf dB gain are processed only for their meters
+            if ((old_tier >= meta::beat_breather::OVL_METERS) && (nOvlTier < meta::beat_breather::OVL_METERS))
+                update_freq_charts();
+            if ((old_tier < meta::beat_breather::OVL_METERS) != (nOvlTier < meta::beat_breather::OVL_METERS))
+                bIdleSync           = true;
+        }
+
+        void beat_breather::update_control_rate()
+        {
+            const size_t ctl_rate   = (nOvlTier >= meta::beat_breather::OVL_ENVELOPE) ? meta::beat_breather::OVL_CTL_DECIMATION : 1;
+            if (ctl_rate == nCtlRate)
+                return;
+            nCtlRate                = ctl_rate;
+            nCtlPhase               = 0;
+
+            // Move the state of envelope estimators to the new control rate, so the envelopes continue smoothly
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b               = &c->vBands[j];
+                    if (!band_processed(b->nMode))
+                        continue;
+
+                    b->nCtlRate             = band_control_rate(b->fCtlTop);
+                    configure_band_control(b, i * meta::beat_breather::BANDS_MAX + j, true);
+                    if (b->sPf.modified())
+                        b->sPf.update_settings();
+                    if (b->sBp.modified())
+                        b->sBp.update_settings();
+                }
+            }
+
+            rebuild_gate_banks();
+        }
+
+        void beat_breather::update_crossover_rank()
+        {
+            const size_t rank       = overload_rank(nXoverRank);
+            const size_t old_rank   = vChannels[0].sCrossover.rank();
+            if ((nFftRank <= 0) || (rank == old_rank))
+                return;
+            const float frame_rate  = fSampleRate / float(size_t(1) << (rank - 1));
+
+            // Change the resolution of the crossover and the spectral processor, the latency is kept by the padding
+            // and the output is taken from the delayed input until the cleared processor produces the valid output
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c            = &vChannels[i];
+                c->sCrossover.set_rank(rank);
+                c->sCrossover.update_settings();
+                c->sCrossover.clear();
+                c->sSpectral.set_rank(rank);
+                c->sSpectral.update_settings();
+                c->sSpectral.clear();
+                restart_engine(c);
+
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                    configure_band_spectral(&c->vBands[j], frame_rate);
+            }
+
+            // The lower rank keeps each second bin of the band masks, the frequency charts are refreshed
+            // when the meters are unfrozen
+            if (nEngine == ENGINE_CROSSOVER)
+                bSpcSync                = true;
+            else if ((!bSpcSync) && (rank + 1 == old_rank) && (vSpcMask != NULL))
+            {
+                const size_t bins       = ((size_t(1) << rank) >> 1) + 1;
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    float *mask             = &vSpcMask[j * nSpcBins];
+                    for (size_t k=0; k<bins; ++k)
+                        mask[k]                 = mask[k * 2];
+                }
+            }
+            else
+                update_spectral_masks();
+            if (nEngine == ENGINE_STATIC)
+                update_static_gain();
+            update_latency();
+        }
+
+        void beat_breather::restart_engine(channel_t *c)
+        {
+            // The output held by the padding is valid only if the previous restart has completed
+            c->nRestartHold         = (c->bRestart) ? 0 : c->nPadDelay;
+            c->nRestart             = 0;
+            c->bRestart             = true;
+        }
+
+        void beat_breather::crossfade_restart(channel_t *c, size_t samples)
+        {
+            // The engine output is valid for the padding delay which was active before the restart, and again
+            // when the latency and the half of the frame filled with silence on restart pass, the delayed input
+            // fills the gap in between. The output held by the padding is read at the padding delay before the restart
+            const size_t hold       = c->nRestartHold;
+            const size_t length     = c->nDelay + ((size_t(1) << c->sCrossover.rank()) >> 1);
+            ring_tail(&c->sPadRing, hold, vBuffer, NULL, GAIN_AMP_0_DB, false, false, samples);
+
+            for (size_t i=0; i<samples; ++i)
+            {
+                const size_t t          = c->nRestart + i;
+                const float k_old       = (t < hold) ? lsp_min(float(hold - t) * fRestartStep, 1.0f) : 0.0f;
+                const float k_new       = (t > length) ? lsp_min(float(t - length) * fRestartStep, 1.0f) : 0.0f;
+                const float dry         = c->vInData[i] * fInGain;
+                c->vOutData[i]          = dry + (vBuffer[i] - dry) * k_old + (c->vOutData[i] - dry) * k_new;
+            }
+
+            c->nRestart            += samples;
+            if ((c->nRestart > length) && (float(c->nRestart - length) * fRestartStep >= 1.0f))
+                c->bRestart             = false;
+        }
+
+        void beat_breather::bind_inputs()
+        {
+            // Meters keep the last measured values under the meters degradation tier
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+
+            for (size_t i=0; i<nChannels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                c->vIn              = c->pIn->buffer<float>();
+                c->vOut             = c->pOut->buffer<float>();
+                if (!meters)
+                    continue;
+
+                c->fInLevel         = GAIN_AMP_M_INF_DB;
+                c->fOutLevel        = GAIN_AMP_M_INF_DB;
+
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b           = &c->vBands[j];
+
+                    b->fInLevel         = GAIN_AMP_M_INF_DB;
+                    b->fOutLevel        = GAIN_AMP_M_INF_DB;
+
+                    b->fPdLevel         = GAIN_AMP_M_INF_DB;
+
+                    b->fPfInGain        = GAIN_AMP_M_INF_DB;
+                    b->fPfOutGain       = GAIN_AMP_M_INF_DB;
+                    b->fPfReduction     = GAIN_AMP_0_DB;
+
+                    b->fBpInGain        = GAIN_AMP_M_INF_DB;
+                    b->fBpOutGain       = GAIN_AMP_M_INF_DB;
+                    b->fBpReduction     = GAIN_AMP_M_INF_DB;
+                }
+            }
+        }
+
+        template <size_t CHANNELS>
+        void beat_breather::split_signal(size_t samples)
+        {
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                // Store the unprocessed input signal to the history
+                ring_push(&c->sHistory, c->vIn, samples);
+                // Apply gain to input signal and pass it to crossover, the unity gain needs no copy
+                const float *in     = c->vIn;
+                if (fInGain != GAIN_AMP_0_DB)
+                {
+                    dsp::mul_k3(c->vInData, c->vIn, fInGain, samples);
+                    in                  = c->vInData;
+                }
+                c->sCrossover.process(in, samples);
+
+                // Read the latency compensation tap of each band for the whole block and measure the input level
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b           = &c->vBands[j];
+                    if (!band_active(b))
+                        continue;
+
+                    float level;
+                    if (bEarly)
+                    {
+                        // Estimate the band from the input history delayed by the early delay, which aligns the
+                        // detection with the output tap, the filters commute with the delay
+                        ring_tail(&c->sHistory, b->nEarlyDelay, vBuffer, NULL, fInGain, false, false, samples);
+                        b->sEarlyHpf.process(b->vInData, vBuffer, samples);
+                        b->sEarlyLpf.process(b->vInData, b->vInData, samples);
+
+                        // The meter shows the crossover band at the output tap, not the estimate
+                        level               = (meters) ? ring_tail(&b->sRing, b->nOutDelay, vBuffer, NULL, GAIN_AMP_0_DB, false, true, samples) : 0.0f;
+                    }
+                    else
+                        level               = ring_tail(&b->sRing, b->nCompDelay, b->vInData, NULL, GAIN_AMP_0_DB, false, meters, samples);
+                    if (meters)
+                        b->fInLevel         = lsp_max(level, b->fInLevel);
+                }
+            }
+        }
+
+        template <size_t CHANNELS>
+        void beat_breather::process_spectral(size_t samples)
+        {
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                // Store the unprocessed input signal to the history
+                ring_push(&c->sHistory, c->vIn, samples);
+                // Apply gain to input signal and band gains to the spectrum of the channel, this requires only one inverse FFT per frame
+                if (fInGain != GAIN_AMP_0_DB)
+                {
+                    dsp::mul_k3(c->vInData, c->vIn, fInGain, samples);
+                    c->sSpectral.process(c->vOutData, c->vInData, samples);
+                }
+                else
+                    c->sSpectral.process(c->vOutData, c->vIn, samples);
+            }
+        }
+
+        void beat_breather::normalize_rms(float *dst, const float *lrms, const float *srms, float gain, size_t samples)
+        {
+            for (size_t i=0; i<samples; ++i)
+            {
+                const float l       = lrms[i];
                 const float s       = srms[i];
                 if ((s > l) && (l >= GAIN_AMP_M_140_DB))
                     dst[i]              = (s * gain) / l;
@@ -1008,136 +2404,892 @@ namespace lsp
             }
         }
 
+        void beat_breather::normalize_rms_linked(float *dl, float *dr, const float *ll, const float *lr,
+            const float *sl, const float *sr, float gain, size_t samples)
+        {
+            // Both channels are converted to mid and normalized in one pass, each channel receives the result
+            for (size_t i=0; i<samples; ++i)
+            {
+                const float l       = (ll[i] + lr[i]) * 0.5f;
+                const float s       = (sl[i] + sr[i]) * 0.5f;
+                const float v       = ((s > l) && (l >= GAIN_AMP_M_140_DB)) ? (s * gain) / l : gain;
+                dl[i]               = v;
+                dr[i]               = v;
+            }
+        }
+
+        size_t beat_breather::decimate_control(float *dst, const float *src, size_t samples, size_t phase, size_t rate)
+        {
+            size_t count        = 0;
+            for (size_t i=(rate - phase) % rate; i<samples; i += rate)
+                dst[count++]        = src[i];
+            return count;
+        }
+
+        float beat_breather::expand_control(float *buf, size_t samples, size_t phase, size_t rate, float hold)
+        {
+            // The buffer contains decimated samples at the beginning, expand them in-place from the end
+            const size_t first  = (rate - phase) % rate;
+            const size_t count  = (samples > first) ? (samples - first + rate - 1) / rate : 0;
+            const float last    = (count > 0) ? buf[count - 1] : hold;
+
+            for (size_t i=samples; i > first; )
+            {
+                --i;
+                buf[i]              = buf[(i - first) / rate];
+            }
+            dsp::fill(buf, hold, lsp_min(first, samples));
+
+            return last;
+        }
+
+        float beat_breather::gate_tau(float sample_rate, float time)
+        {
+            // The same coefficient as dspu::Gate computes for the attack and release time
+            return 1.0f - expf(logf(1.0f - M_SQRT1_2) / (dspu::millis_to_samples(sample_rate, time)));
+        }
+
+        void beat_breather::init_gate_bank(gate_bank_t *gb)
+        {
+            gb->nGates          = 0;
+            gb->nLanes          = GATE_LANES_MIN;
+
+            for (size_t i=0; i<GATE_LANES_MAX; ++i)
+            {
+                gb->vSlot[i]        = 0;
+                gb->vIn[i]          = NULL;
+                gb->vOut[i]         = NULL;
+                gb->vEnv[i]         = 0.0f;
+                gb->vTauAttack[i]   = 0.0f;
+                gb->vTauRelease[i]  = 0.0f;
+                gb->vSlotEnv[i]     = 0.0f;
+            }
+        }
+
+        void beat_breather::reset_gate_bank(gate_bank_t *gb)
+        {
+            // Save the envelope of active gates to their slots
+            for (size_t i=0; i<gb->nGates; ++i)
+                gb->vSlotEnv[gb->vSlot[i]]  = gb->vEnv[i];
+
+            // Release all lanes, unused lanes should stay silent
+            for (size_t i=0; i<GATE_LANES_MAX; ++i)
+            {
+                gb->vIn[i]          = NULL;
+                gb->vOut[i]         = NULL;
+                gb->vEnv[i]         = 0.0f;
+                gb->vTauAttack[i]   = 0.0f;
+                gb->vTauRelease[i]  = 0.0f;
+            }
+
+            gb->nGates          = 0;
+            gb->nLanes          = GATE_LANES_MIN;
+        }
+
+        void beat_breather::move_gate_slot(gate_bank_t *dst, const gate_bank_t *src, size_t slot)
+        {
+            // The active gate holds the actual envelope, the inactive slot keeps the saved one
+            float env           = src->vSlotEnv[slot];
+            for (size_t i=0; i<src->nGates; ++i)
+            {
+                if (src->vSlot[i] == slot)
+                    env                 = src->vEnv[i];
+            }
+
+            dst->vSlotEnv[slot] = env;
+        }
+
+        void beat_breather::add_gate(gate_bank_t *gb, size_t slot, const float *in, float *out, float tau_attack, float tau_release)
+        {
+            const size_t lane   = gb->nGates++;
+
+            gb->vSlot[lane]         = slot;
+            gb->vIn[lane]           = in;
+            gb->vOut[lane]          = out;
+            gb->vEnv[lane]          = gb->vSlotEnv[slot];
+            gb->vTauAttack[lane]    = tau_attack;
+            gb->vTauRelease[lane]   = tau_release;
+
+            // Round the number of lanes up to 4, 8 or 16
+            while (gb->nLanes < gb->nGates)
+                gb->nLanes            <<= 1;
+        }
+
+        void beat_breather::process_gate_bank(gate_bank_t *gb, float *buf, size_t samples)
+        {
+            const size_t gates  = gb->nGates;
+            const size_t lanes  = gb->nLanes;
+            const size_t chunk  = BUFFER_SIZE / lanes;
+            if (gates == 0)
+                return;
+
+            for (size_t offset=0; offset<samples; )
+            {
+                const size_t to_do  = lsp_min(samples - offset, chunk);
+
+                // Interleave the sidechain signal of all gates, unused lanes are filled with zeros
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    float *dst          = &buf[j];
+                    if (j < gates)
+                    {
+                        const float *src    = &gb->vIn[j][offset];
+                        for (size_t k=0; k<to_do; ++k, dst += lanes)
+                            *dst                = src[k];
+                    }
+                    else
+                    {
+                        for (size_t k=0; k<to_do; ++k, dst += lanes)
+                            *dst                = 0.0f;
+                    }
+                }
+
+                // Advance the envelope of all lanes at once
+                switch (lanes)
+                {
+                    case 4:
+                        gate_bank_envelope<4>(buf, gb->vEnv, gb->vTauAttack, gb->vTauRelease, to_do);
+                        break;
+                    case 8:
+                        gate_bank_envelope<8>(buf, gb->vEnv, gb->vTauAttack, gb->vTauRelease, to_do);
+                        break;
+                    default:
+                        gate_bank_envelope<GATE_LANES_MAX>(buf, gb->vEnv, gb->vTauAttack, gb->vTauRelease, to_do);
+                        break;
+                }
+
+                // De-interleave the envelope of all gates
+                for (size_t j=0; j<gates; ++j)
+                {
+                    const float *src    = &buf[j];
+                    float *dst          = &gb->vOut[j][offset];
+                    for (size_t k=0; k<to_do; ++k, src += lanes)
+                        dst[k]              = *src;
+                }
+
+                offset             += to_do;
+            }
+        }
+
+        void beat_breather::init_rms_bank(rms_bank_t *rb, size_t lanes)
+        {
+            rb->nLanes          = lanes;
+            rb->nCapacity       = 0;
+            rb->nHead           = 0;
+            rb->vHistory        = NULL;
+
+            for (size_t i=0; i<RMS_LANES_MAX; ++i)
+            {
+                rb->vIn[i]          = NULL;
+                rb->vLongOut[i]     = NULL;
+                rb->vShortOut[i]    = NULL;
+                rb->vLong[i]        = 1;
+                rb->vShort[i]       = 1;
+                rb->vLongScale[i]   = 1.0f;
+                rb->vShortScale[i]  = 1.0f;
+                rb->vLongSum[i]     = 0.0;
+                rb->vShortSum[i]    = 0.0;
+                rb->vSeedHead[i]    = 0;
+                rb->vSeedLeft[i]    = 0;
+                rb->vSeedSplit[i]   = 0;
+                rb->vSeedLength[i]  = 0;
+                rb->vSeedNear[i]    = 0.0f;
+                rb->vSeedFar[i]     = 0.0f;
+            }
+        }
+
+        void beat_breather::clear_rms_bank(rms_bank_t *rb)
+        {
+            rb->nHead           = 0;
+            if (rb->vHistory != NULL)
+                dsp::fill_zero(rb->vHistory, rb->nCapacity * rb->nLanes);
+
+            for (size_t i=0; i<RMS_LANES_MAX; ++i)
+            {
+                rb->vLongSum[i]     = 0.0;
+                rb->vShortSum[i]    = 0.0;
+                rb->vSeedLeft[i]    = 0;
+            }
+        }
+
+        void beat_breather::seed_rms_lane(rms_bank_t *rb, size_t lane, size_t long_len, size_t short_len,
+            double long_mean, double short_mean)
+        {
+            // The history is not rewritten at once: the lane gets the running sums of the given mean squares and
+            // fill_rms_seed() writes the matching values to the history right before the windows read them.
+            // The part covered by both windows keeps the mean of the shorter window, the rest completes the
+            // mean of the longer window, so both windows continue from the given means
+            const bool short_first  = short_len <= long_len;
+            const size_t near_len   = (short_first) ? short_len : long_len;
+            const size_t far_len    = (short_first) ? long_len : short_len;
+            const double near_mean  = (short_first) ? short_mean : long_mean;
+            const double far_mean   = (short_first) ? long_mean : short_mean;
+            const float v_near      = float(lsp_max(near_mean, 0.0));
+            const float v_far       = (far_len > near_len) ?
+                float(lsp_max((far_mean * far_len - near_mean * near_len) / double(far_len - near_len), 0.0)) : v_near;
+            const double near_sum   = double(v_near) * near_len;
+            const double far_sum    = near_sum + double(v_far) * (far_len - near_len);
+
+            rb->vLong[lane]         = long_len;
+            rb->vShort[lane]        = short_len;
+            rb->vLongSum[lane]      = (short_first) ? far_sum : near_sum;
+            rb->vShortSum[lane]     = (short_first) ? near_sum : far_sum;
+            rb->vSeedHead[lane]     = rb->nHead;
+            rb->vSeedLeft[lane]     = (rb->vHistory != NULL) ? far_len : 0;
+            rb->vSeedSplit[lane]    = near_len;
+            rb->vSeedLength[lane]   = far_len;
+            rb->vSeedNear[lane]     = v_near;
+            rb->vSeedFar[lane]      = v_far;
+        }
+
+        void beat_breather::fill_rms_seed(rms_bank_t *rb, size_t lane, size_t samples)
+        {
+            // The window of length 'w' reads the sample which is 'w - t' samples older than the write position
+            // at the moment of seeding, 't' is the number of samples processed since seeding
+            const size_t cap        = rb->nCapacity;
+            const size_t stride     = rb->nLanes;
+            const size_t passed     = rb->vSeedLength[lane] - rb->vSeedLeft[lane];
+            const size_t count      = lsp_min(samples, rb->vSeedLeft[lane]);
+            const size_t windows[2] = { rb->vLong[lane], rb->vShort[lane] };
+
+            for (size_t i=0; i<2; ++i)
+            {
+                const size_t w          = windows[i];
+                for (size_t k=0; (k < count) && (passed + k < w); ++k)
+                {
+                    const size_t age        = w - passed - k;
+                    const size_t pos        = (rb->vSeedHead[lane] + cap - age) % cap;
+                    rb->vHistory[pos * stride + lane]   = (age <= rb->vSeedSplit[lane]) ? rb->vSeedNear[lane] : rb->vSeedFar[lane];
+                }
+            }
+
+            rb->vSeedLeft[lane]    -= count;
+        }
+
+        void beat_breather::set_rms_lane(rms_bank_t *rb, size_t lane, const float *in, float *lrms, float *srms,
+            size_t long_len, size_t short_len, float short_gain)
+        {
+            // The window can not be longer than the history
+            const size_t max_len    = lsp_max(rb->nCapacity, size_t(2)) - 1;
+            long_len                = lsp_limit(long_len, size_t(1), max_len);
+            short_len               = lsp_limit(short_len, size_t(1), max_len);
+            const bool start        = (rb->vIn[lane] == NULL) && (in != NULL);
+
+            rb->vIn[lane]           = in;
+            rb->vLongOut[lane]      = lrms;
+            rb->vShortOut[lane]     = srms;
+            if (in == NULL)
+            {
+                rb->vSeedLeft[lane]     = 0;
+                return;
+            }
+
+            // The lane may have been skipped while inactive, start it with the silent history. The changed
+            // window continues from the mean squares of the previous windows
+            if (start)
+                seed_rms_lane(rb, lane, long_len, short_len, 0.0, 0.0);
+            else if ((rb->vLong[lane] != long_len) || (rb->vShort[lane] != short_len))
+                seed_rms_lane(rb, lane, long_len, short_len,
+                    rb->vLongSum[lane] / double(rb->vLong[lane]),
+                    rb->vShortSum[lane] / double(rb->vShort[lane]));
+
+            // The gain is applied to the signal before squaring, so it is squared too
+            rb->vLongScale[lane]    = 1.0f / float(long_len);
+            rb->vShortScale[lane]   = (short_gain * short_gain) / float(short_len);
+        }
+
+        void beat_breather::move_rms_lane(rms_bank_t *dst, const rms_bank_t *src, size_t lane)
+        {
+            // The mean squares do not depend on the control rate, so the lane continues from the means of the source
+            seed_rms_lane(dst, lane, dst->vLong[lane], dst->vShort[lane],
+                src->vLongSum[lane] / double(src->vLong[lane]),
+                src->vShortSum[lane] / double(src->vShort[lane]));
+        }
+
+        void beat_breather::process_rms_bank(rms_bank_t *rb, float *buf, size_t samples)
+        {
+            // Lanes above the last active one are not processed at all
+            size_t lanes        = rb->nLanes;
+            while ((lanes > 0) && (rb->vIn[lanes - 1] == NULL))
+                --lanes;
+            if ((lanes == 0) || (samples == 0))
+                return;
+
+            const size_t stride = rb->nLanes;
+            const size_t cap    = rb->nCapacity;
+            const size_t chunk  = BUFFER_SIZE / (lanes * 2);
+            float *lbuf         = buf;
+            float *sbuf         = &buf[chunk * lanes];
+
+            // Output silence if there is no history
+            if (rb->vHistory == NULL)
+            {
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    if (rb->vIn[j] == NULL)
+                        continue;
+                    dsp::fill_zero(rb->vLongOut[j], samples);
+                    dsp::fill_zero(rb->vShortOut[j], samples);
+                }
+                return;
+            }
+
+            for (size_t offset=0; offset<samples; )
+            {
+                const size_t to_do  = lsp_min(samples - offset, chunk);
+
+                // Write the seeds of recently started lanes to the history read by this chunk
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    if (rb->vSeedLeft[j] > 0)
+                        fill_rms_seed(rb, j, to_do);
+                }
+
+                // Interleave the squared signal of all lanes, inactive lanes are filled with zeros
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    float *dst          = &lbuf[j];
+                    const float *src    = rb->vIn[j];
+                    if (src != NULL)
+                    {
+                        src                += offset;
+                        for (size_t k=0; k<to_do; ++k, dst += lanes)
+                            *dst                = src[k] * src[k];
+                    }
+                    else
+                    {
+                        for (size_t k=0; k<to_do; ++k, dst += lanes)
+                            *dst                = 0.0f;
+                    }
+                }
+
+                // Advance the sliding windows of all lanes at once
+                for (size_t k=0; k<to_do; ++k)
+                {
+                    const size_t head   = rb->nHead;
+                    float *h            = &rb->vHistory[head * stride];
+                    float *l            = &lbuf[k * lanes];
+                    float *s            = &sbuf[k * lanes];
+
+                    for (size_t j=0; j<lanes; ++j)
+                    {
+                        const size_t lt     = (head >= rb->vLong[j]) ? head - rb->vLong[j] : head + cap - rb->vLong[j];
+                        const size_t st     = (head >= rb->vShort[j]) ? head - rb->vShort[j] : head + cap - rb->vShort[j];
+                        const float x2      = l[j];
+
+                        h[j]                = x2;
+                        rb->vLongSum[j]    += x2 - rb->vHistory[lt * stride + j];
+                        rb->vShortSum[j]   += x2 - rb->vHistory[st * stride + j];
+                        l[j]                = float(rb->vLongSum[j]) * rb->vLongScale[j];
+                        s[j]                = float(rb->vShortSum[j]) * rb->vShortScale[j];
+                    }
+
+                    rb->nHead           = (head + 1 < cap) ? head + 1 : 0;
+                }
+
+                // De-interleave the RMS of active lanes
+                for (size_t j=0; j<lanes; ++j)
+                {
+                    if (rb->vIn[j] == NULL)
+                        continue;
+
+                    const float *l      = &lbuf[j];
+                    const float *s      = &sbuf[j];
+                    float *lrms         = &rb->vLongOut[j][offset];
+                    float *srms         = &rb->vShortOut[j][offset];
+                    for (size_t k=0; k<to_do; ++k, l += lanes, s += lanes)
+                    {
+                        lrms[k]             = (*l > 0.0f) ? sqrtf(*l) : 0.0f;
+                        srms[k]             = (*s > 0.0f) ? sqrtf(*s) : 0.0f;
+                    }
+                }
+
+                offset             += to_do;
+            }
+        }
+
+        void beat_breather::init_ring(ring_t *r, float *data, size_t capacity)
+        {
+            r->vData            = data;
+            r->nCapacity        = (data != NULL) ? capacity : 0;
+            r->nHead            = 0;
+            r->nRemapHead       = 0;
+            r->nRemapLength     = 0;
+            r->nRemapPushed     = 0;
+            r->nRemapFrom       = 1;
+            r->nRemapTo         = 1;
+            if (data != NULL)
+                dsp::fill_zero(data, capacity);
+        }
+
+        void beat_breather::ring_push(ring_t *r, const float *src, size_t count)
+        {
+            if (r->vData == NULL)
+                return;
+
+            for (size_t offset=0; offset<count; )
+            {
+                const size_t to_do  = lsp_min(count - offset, r->nCapacity - r->nHead);
+                dsp::copy(&r->vData[r->nHead], &src[offset], to_do);
+                r->nHead            = (r->nHead + to_do) % r->nCapacity;
+                offset             += to_do;
+            }
+
+            // The remapping ends when the samples written before the change of the rate can not be read anymore
+            if (r->nRemapLength > 0)
+            {
+                r->nRemapPushed    += count;
+                if (r->nRemapPushed >= r->nRemapLength + BUFFER_SIZE)
+                    r->nRemapLength     = 0;
+            }
+        }
+
+        float beat_breather::ring_tail(const ring_t *r, size_t delay, float *dst, const float *vca, float gain, bool add, bool peak, size_t count)
+        {
+            if (r->vData == NULL)
+            {
+                if (!add)
+                    dsp::fill_zero(dst, count);
+                return 0.0f;
+            }
+            if (r->nRemapLength > 0)
+                return ring_remap_tail(r, delay, dst, vca, gain, add, peak, count);
+
+            // The delayed block starts (count + delay) samples before the write position
+            size_t tail         = (r->nHead + r->nCapacity * 2 - count - delay) % r->nCapacity;
+            float level         = 0.0f;
+
+            for (size_t offset=0; offset<count; )
+            {
+                const size_t to_do  = lsp_min(count - offset, r->nCapacity - tail);
+                const float l       = fused_apply(
+                    &dst[offset], &r->vData[tail], (vca != NULL) ? &vca[offset] : NULL,
+                    gain, add, peak, to_do);
+                level               = lsp_max(level, l);
+                tail                = (tail + to_do) % r->nCapacity;
+                offset             += to_do;
+            }
+
+            return level;
+        }
+
+        float beat_breather::ring_remap_tail(const ring_t *r, size_t delay, float *dst, const float *vca, float gain, bool add, bool peak, size_t count)
+        {
+            // The sample 'age' positions before the change of the rate matches the sample 'age * to / from'
+            // positions before the change at the old rate. The samples written after the change only overwrite
+            // the oldest samples of the ring, so the old samples stay intact until the remapping ends
+            const size_t cap    = r->nCapacity;
+            size_t tail         = (r->nHead + cap * 2 - count - delay) % cap;
+            float level         = 0.0f;
+
+            for (size_t i=0; i<count; ++i)
+            {
+                const size_t age    = (r->nRemapHead + cap - tail) % cap;
+                size_t pos          = tail;
+                if ((age > 0) && (age <= r->nRemapLength) && (age + r->nRemapPushed < cap))
+                {
+                    const size_t k      = ((age - 1) * r->nRemapTo) / r->nRemapFrom + 1;
+                    pos                 = (k < cap) ? (r->nRemapHead + cap - k) % cap : cap;
+                }
+
+                float s             = (pos < cap) ? r->vData[pos] * gain : 0.0f;
+                if (vca != NULL)
+                    s                  *= vca[i];
+                if (peak)
+                    level               = lsp_max(level, fabsf(s));
+                dst[i]              = (add) ? dst[i] + s : s;
+                tail                = (tail + 1 < cap) ? tail + 1 : 0;
+            }
+
+            return level;
+        }
+
+        void beat_breather::remap_ring(ring_t *r, size_t length, size_t from, size_t to)
+        {
+            if ((r->vData == NULL) || (from == to))
+                return;
+
+            // The samples are not moved, ring_tail() reads the samples written before the change at the
+            // positions of the old rate until they leave the delay of the given length
+            r->nRemapHead       = r->nHead;
+            r->nRemapLength     = lsp_min(length, r->nCapacity - 1);
+            r->nRemapPushed     = 0;
+            r->nRemapFrom       = from;
+            r->nRemapTo         = to;
+        }
+
+        float beat_breather::fused_apply(float *dst, const float *src, const float *vca, float gain, bool add, bool peak, size_t count)
+        {
+            const size_t index  = ((gain != GAIN_AMP_0_DB) ? 8 : 0) | ((vca != NULL) ? 4 : 0) | ((add) ? 2 : 0) | ((peak) ? 1 : 0);
+            return fused_kernels[index](dst, src, vca, gain, count);
+        }
+
+        int32_t beat_breather::curve_cache_key(float value)
+        {
+            const float db      = dspu::gain_to_db(lsp_max(value, GAIN_AMP_M_140_DB));
+            return int32_t(roundf(db * CURVE_CACHE_QUANTIZE));
+        }
+
+        void beat_breather::gate_curve(float *dst, dspu::Gate *gate, const float *x, size_t type,
+            float threshold, float zone, float reduction, float makeup)
+        {
+            const size_t count  = meta::beat_breather::CURVE_MESH_POINTS;
+
+            // Do not wait for other instance which holds the cache, just compute the curve
+            if (!atomic_cas(&curve_cache_lock, 0, 1))
+            {
+                gate->curve(dst, x, count, false);
+                dsp::mul_k2(dst, makeup, count);
+                return;
+            }
+            lsp_finally { atomic_store(&curve_cache_lock, 0); };
+
+            const int32_t key[CURVE_CACHE_KEY] =
+            {
+                int32_t(type),
+                curve_cache_key(threshold),
+                curve_cache_key(zone),
+                curve_cache_key(reduction),
+                curve_cache_key(makeup)
+            };
+
+            // Lookup for the curve, remember the least recently used entry
+            if ((++curve_cache_clock) == 0)
+                curve_cache_clock   = 1;
+            curve_cache_entry_t *victim = &curve_cache[0];
+            for (size_t i=0; i<CURVE_CACHE_SIZE; ++i)
+            {
+                curve_cache_entry_t *e  = &curve_cache[i];
+                if ((e->nStamp != 0) && (memcmp(e->vKey, key, sizeof(key)) == 0))
+                {
+                    e->nStamp               = curve_cache_clock;
+                    dsp::copy(dst, e->vCurve, count);
+                    return;
+                }
+                if (e->nStamp < victim->nStamp)
+                    victim                  = e;
+            }
+
+            // Compute the curve with makeup gain and replace the least recently used entry
+            gate->curve(dst, x, count, false);
+            dsp::mul_k2(dst, makeup, count);
+
+            memcpy(victim->vKey, key, sizeof(key));
+            victim->nStamp          = curve_cache_clock;
+            dsp::copy(victim->vCurve, dst, count);
+        }
+
+        ssize_t beat_breather::acquire_phase_slot()
+        {
+            for (size_t i=0; i<PHASE_SLOTS; ++i)
+            {
+                if (atomic_cas(&phase_slots[i], 0, 1))
+                    return i;
+            }
+            return -1;
+        }
+
+        void beat_breather::release_phase_slot(ssize_t slot)
+        {
+            if ((slot >= 0) && (size_t(slot) < PHASE_SLOTS))
+                atomic_store(&phase_slots[slot], 0);
+        }
+
+        float beat_breather::phase_slot_value(size_t slot)
+        {
+            // Van der Corput sequence: the bit-reversed slot number spreads any count
+            // of consecutively allocated slots evenly over the crossover frame
+            float phase         = 0.0f;
+            for (float k = 0.5f; slot > 0; slot >>= 1, k *= 0.5f)
+            {
+                if (slot & 1)
+                    phase              += k;
+            }
+            return phase;
+        }
+
+        size_t beat_breather::band_control_rate(float top) const
+        {
+            size_t rate         = nCtlRate;
+            if (!bMultirate)
+                return rate;
+
+            // Decimate the envelope path while the decimated rate stays well above the upper band frequency
+            while ((rate < meta::beat_breather::MULTIRATE_MAX) &&
+                   (fSampleRate >= top * meta::beat_breather::MULTIRATE_MARGIN * float(rate * 2)))
+                rate              <<= 1;
+
+            return rate;
+        }
+
+        void beat_breather::update_early_filter(dspu::Filter *f, size_t type, float freq, float slope) const
+        {
+            // Approximate the slope of the crossover filter by the nearest order of the Linkwitz-Riley filter
+            const size_t order  = size_t(slope / meta::beat_breather::EARLY_SLOPE_STEP + 0.5f);
+
+            dspu::filter_params_t fp;
+            fp.nType            = (order > 0) ? type : size_t(dspu::FLT_NONE);
+            fp.fFreq            = freq;
+            fp.fFreq2           = freq;
+            fp.fGain            = GAIN_AMP_0_DB;
+            fp.nSlope           = order;
+            fp.fQuality         = 0.0f;
+
+            f->update(fSampleRate, &fp);
+        }
+
+        size_t beat_breather::early_group_delay(band_t *b, float freq) const
+        {
+            // Estimate the group delay from the phase difference at two close frequencies
+            float f[2], re[2], im[2], phase[2];
+            f[0]                = freq * (1.0f - EARLY_GD_SPAN);
+            f[1]                = freq * (1.0f + EARLY_GD_SPAN);
+            phase[0]            = 0.0f;
+            phase[1]            = 0.0f;
+
+            dspu::Filter *filters[2] = { &b->sEarlyHpf, &b->sEarlyLpf };
+            for (size_t i=0; i<2; ++i)
+            {
+                filters[i]->freq_chart(re, im, f, 2);
+                for (size_t k=0; k<2; ++k)
+                    phase[k]           += atan2f(im[k], re[k]);
+            }
+
+            // Wrap the phase difference, the frequency span is small enough to keep it below PI
+            float dphi          = phase[0] - phase[1];
+            while (dphi > M_PI)
+                dphi               -= 2.0f * M_PI;
+            while (dphi < -M_PI)
+                dphi               += 2.0f * M_PI;
+
+            const float gd      = dphi * fSampleRate / (2.0f * M_PI * (f[1] - f[0]));
+            return (gd > 0.0f) ? size_t(gd + 0.5f) : 0;
+        }
+
+        size_t beat_breather::control_samples(size_t samples, size_t rate) const
+        {
+            const size_t first  = (rate - nCtlPhase % rate) % rate;
+            return (samples > first) ? (samples - first + rate - 1) / rate : 0;
+        }
+
+        template <size_t CHANNELS, bool LINKED>
         void beat_breather::apply_peak_detector(size_t samples)
         {
-            // Esimate RMS for all bands
-            for (size_t i=0; i<nChannels; ++i)
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+
+            // Decimate the band signal to the envelope control rate of the band if required
+            for (size_t i=0; i<CHANNELS; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *b           = &c->vBands[j];
-                    if (b->nMode == BAND_OFF)
+                    if ((band_active(b)) && (b->nCtlRate > 1))
+                        decimate_control(b->vBpData, b->vInData, samples, nCtlPhase % b->nCtlRate, b->nCtlRate);
+                }
+            }
+
+            // Estimate long-time RMS and short-time RMS for all bands of the same control rate at once
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+                process_rms_bank(&vRmsBanks[i], vBuffer, control_samples(samples, size_t(1) << i));
+
+            // Apply delay compensation to short-time RMS estimation
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b           = &c->vBands[j];
+                    if (!band_active(b))
                         continue;
 
-                    // Estimate long-time RMS
-                    b->sPdLong.process(b->vPdData, const_cast<const float **>(&b->vInData), samples);
-                    // Estimate short-time RMS
-                    b->sPdShort.process(b->vPfData, const_cast<const float **>(&b->vInData), samples);
-                    // Apply delay compensation to short-time RMS estimation
-                    b->sPdDelay.process(b->vPfData, b->vPfData, samples);
+                    const size_t count  = control_samples(samples, b->nCtlRate);
+                    ring_push(&b->sPdRing, b->vPfData, count);
+                    ring_tail(&b->sPdRing, b->nPdDelay, b->vPfData, NULL, GAIN_AMP_0_DB, false, false, count);
                 }
             }
 
-            // Mix sidechain if 'Stereo Split' is not enabled
-            if ((nChannels > 1) && (!bStereoSplit))
+            // Mix sidechain if 'Stereo Split' is not enabled, both channels are handled by the same loop
+            if (LINKED)
             {
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *left    = &vChannels[0].vBands[j];
                     band_t *right   = &vChannels[1].vBands[j];
-                    if ((left->nMode == BAND_OFF) || (right->nMode == BAND_OFF))
+                    if ((!band_active(left)) || (!band_active(right)))
                         continue;
 
-                    // Convert stereo long-time RMS to mono
-                    dsp::lr_to_mid(left->vPdData, left->vPdData, right->vPdData, samples);
-                    // Duplicate long-time RMS to second channel
-                    dsp::copy(right->vPdData, left->vPdData, samples);
-                    // Convert stereo short-time RMS to mono
-                    dsp::lr_to_mid(left->vPfData, left->vPfData, right->vPfData, samples);
-                    // Duplicate short-time RMS to second channel
-                    dsp::copy(right->vPfData, left->vPfData, samples);
+                    // Both channels share the same split frequencies and thus the same control rate
+                    const size_t count  = control_samples(samples, left->nCtlRate);
+
+                    // Produce normalized Peak/RMS signal from the mid of stereo long-time and short-time RMS
+                    normalize_rms_linked(
+                        left->vPdData, right->vPdData,
+                        left->vPdData, right->vPdData,
+                        left->vPfData, right->vPfData,
+                        left->fPdMakeup, count);
                 }
             }
 
             // Do post-processing and normalization
-            for (size_t i=0; i<nChannels; ++i)
+            for (size_t i=0; i<CHANNELS; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *b           = &c->vBands[j];
-                    if (b->nMode == BAND_OFF)
+                    if (!band_active(b))
                         continue;
 
-                    // Produce normalized Peak/RMS signal
-                    normalize_rms(b->vPdData, b->vPdData, b->vPfData, b->fPdMakeup, samples);
-                    b->sPdMeter.process(b->vPdData, samples);
-                    b->fPdLevel     = lsp_max(b->fPdLevel, dsp::abs_max(b->vPdData, samples));
+                    const size_t count  = control_samples(samples, b->nCtlRate);
+
+                    // Produce normalized Peak/RMS signal, the linked channels have it already
+                    if (!LINKED)
+                        normalize_rms(b->vPdData, b->vPdData, b->vPfData, b->fPdMakeup, count);
+                    if ((meters) && (count > 0))
+                    {
+                        // The time graph is accumulated only when it is visible
+                        if (nTab == meta::beat_breather::TAB_PUNCH_DETECTOR)
+                            b->sPdMeter.process(b->vPdData, count);
+                        b->fPdLevel     = lsp_max(b->fPdLevel, dsp::abs_max(b->vPdData, count));
+                    }
                 }
             }
         }
 
+        template <size_t CHANNELS>
         void beat_breather::apply_punch_filter(size_t samples)
         {
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+
+            // Compute the envelope of all punch filters of the same control rate at once and store it to band_t::vPfData
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+                process_gate_bank(&vPfBanks[i], vBuffer, control_samples(samples, size_t(1) << i));
+
             // Do post-processing and normalization
-            for (size_t i=0; i<nChannels; ++i)
+            for (size_t i=0; i<CHANNELS; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *b           = &c->vBands[j];
-                    if (b->nMode == BAND_OFF)
+                    if (!band_active(b))
                         continue;
 
-                    // Process sidechain signal and produce VCA
-                    b->sPf.process(b->vPfData, vBuffer, b->vPdData, samples);
+                    const size_t count  = control_samples(samples, b->nCtlRate);
+
+                    // Produce VCA from the envelope, the gate curve is monotonic so the settled
+                    // envelope gives the constant VCA when both of its bounds map to the same gain
+                    float env_min = 0.0f, env_max = 0.0f;
+                    if (count > 0)
+                        dsp::minmax(b->vPfData, count, &env_min, &env_max);
+                    const float vca     = b->sPf.amplification(env_max);
+                    const bool steady   = (count > 0) && (b->sPf.amplification(env_min) == vca);
+                    if (!steady)
+                        b->sPf.amplification(vBuffer, b->vPfData, count, false);
                     // Update gating dot meter
-                    size_t idx = dsp::max_index(b->vPfData, samples);
-                    if (vBuffer[idx] > b->fPfInGain)
+                    if ((meters) && (count > 0))
                     {
-                        b->fPfInGain    = vBuffer[idx];
-                        b->fPfOutGain   = b->vPfData[idx] * b->fPfInGain;
+                        size_t idx = (steady) ? 0 : dsp::max_index(vBuffer, count);
+                        if (b->vPfData[idx] > b->fPfInGain)
+                        {
+                            b->fPfInGain    = b->vPfData[idx];
+                            b->fPfOutGain   = ((steady) ? vca : vBuffer[idx]) * b->fPfInGain;
+                        }
+                        b->fPfReduction = lsp_min((steady) ? vca : dsp::abs_min(vBuffer, count), b->fPfReduction);
                     }
-                    b->fPfReduction = lsp_min(dsp::abs_min(b->vPfData, samples), b->fPfReduction);
-                    // Apply lookahead delay to Peak/RMS signal
-                    b->sPfDelay.process(vBuffer, b->vPdData, samples);
-                    // Apply VCA to peak signal
-                    dsp::mul2(b->vPfData, vBuffer, samples);
+                    // Apply lookahead delay to Peak/RMS signal and apply VCA to it
+                    ring_push(&b->sPfRing, b->vPdData, count);
+                    ring_tail(&b->sPfRing, b->nPfDelay, b->vPfData, (steady) ? NULL : vBuffer, (steady) ? vca : GAIN_AMP_0_DB, false, false, count);
                 }
             }
         }
 
+        template <size_t CHANNELS>
         void beat_breather::apply_beat_processor(size_t samples)
         {
-            // Process the data stored in band_t::vPfData and band_t::vIn and store result to band_t::vData
-            for (size_t i=0; i<nChannels; ++i)
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+
+            // Apply time shift delay to the sidechain
+            for (size_t i=0; i<CHANNELS; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *b           = &c->vBands[j];
-                    if (b->nMode == BAND_OFF)
+                    if (!band_active(b))
+                        continue;
+
+                    const size_t count  = control_samples(samples, b->nCtlRate);
+                    ring_push(&b->sBpScRing, b->vPfData, count);
+                    ring_tail(&b->sBpScRing, b->nBpScDelay, b->vBpData, NULL, GAIN_AMP_0_DB, false, false, count);
+                }
+            }
+
+            // Compute the envelope of all beat processors of the same control rate at once and store it to band_t::vBpData
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+                process_gate_bank(&vBpBanks[i], vBuffer, control_samples(samples, size_t(1) << i));
+
+            // Process the data stored in band_t::vBpData and band_t::vIn, store VCA to band_t::vBpData
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+
+                for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+                {
+                    band_t *b           = &c->vBands[j];
+                    if (!band_active(b))
                         continue;
 
-                    // Apply time shift delay to the sidechain
-                    b->sBpScDelay.process(b->vBpData, b->vPfData, samples);
-                    // Process sidechain signal and produce VCA
-                    b->sBp.process(b->vBpData, vBuffer, b->vBpData, samples);
+                    const size_t count  = control_samples(samples, b->nCtlRate);
+
+                    // Produce VCA from the envelope, the settled envelope gives the constant VCA which is
+                    // applied as a gain by mix_bands(), the held value of the decimated VCA should match it too
+                    float env_min = 0.0f, env_max = 0.0f;
+                    if (count > 0)
+                        dsp::minmax(b->vBpData, count, &env_min, &env_max);
+                    const float vca     = b->sBp.amplification(env_max);
+                    b->bBpSteady        = (count > 0) && (b->sBp.amplification(env_min) == vca) &&
+                                          ((b->nCtlRate <= 1) || (b->fBpHold == vca * b->fBpMakeup));
+                    if (!b->bBpSteady)
+                        b->sBp.amplification(vBuffer, b->vBpData, count, false);
                     // Update gating dot meter
-                    size_t idx = dsp::max_index(b->vBpData, samples);
-                    if (vBuffer[idx] > b->fBpInGain)
+                    if ((meters) && (count > 0))
+                    {
+                        size_t idx = (b->bBpSteady) ? 0 : dsp::max_index(vBuffer, count);
+                        if (b->vBpData[idx] > b->fBpInGain)
+                        {
+                            b->fBpInGain    = b->vBpData[idx];
+                            b->fBpOutGain   = ((b->bBpSteady) ? vca : vBuffer[idx]) * b->fBpInGain * b->fBpMakeup;
+                        }
+                        b->fBpReduction = lsp_max(((b->bBpSteady) ? vca : dsp::abs_max(vBuffer, count)) * b->fBpMakeup, b->fBpReduction);
+                    }
+                    if (b->bBpSteady)
                     {
-                        b->fBpInGain    = vBuffer[idx];
-                        b->fBpOutGain   = b->vBpData[idx] * b->fBpInGain * b->fBpMakeup;
+                        b->fBpSteady    = vca * b->fBpMakeup;
+                        b->fBpHold      = b->fBpSteady;
+                        continue;
                     }
-                    b->fBpReduction = lsp_max(dsp::abs_max(b->vBpData, samples) * b->fBpMakeup, b->fBpReduction);
-                    // Apply time shift delay + latency compensation to the signal of the band
-                    b->sBpDelay.process(b->vInData, b->vInData, samples);
-                    // Apply VCA to original signal
-                    dsp::fmmul_k3(b->vBpData, b->vInData, b->fBpMakeup, samples);
+                    // Store the VCA with makeup gain and restore it at the audio rate
+                    dsp::mul_k3(b->vBpData, vBuffer, b->fBpMakeup, count);
+                    if (b->nCtlRate > 1)
+                        b->fBpHold      = expand_control(b->vBpData, samples, nCtlPhase % b->nCtlRate, b->nCtlRate, b->fBpHold);
                 }
             }
         }
 
+        template <size_t CHANNELS>
         void beat_breather::mix_bands(size_t samples)
         {
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+
             // Mix bands depending on the band listen mode
-            for (size_t i=0; i<nChannels; ++i)
+            for (size_t i=0; i<CHANNELS; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
@@ -1146,7 +3298,10 @@ namespace lsp
                 ssize_t num_pd      = 0;
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
-                    switch (c->vBands[j].nMode)
+                    const band_t *b     = &c->vBands[j];
+                    if ((b->nMode == BAND_OFF) || ((b->nMode == BAND_MUTE) && (b->fMute <= 0.0f)))
+                        continue;
+                    switch (b->nMixMode)
                     {
                         case BAND_PD:
                         case BAND_PF:
@@ -1163,39 +3318,61 @@ namespace lsp
                 for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                 {
                     band_t *b           = &c->vBands[j];
-                    switch (b->nMode)
+                    float level         = 0.0f;
+                    if ((b->nMode == BAND_OFF) || (b->bIdle))
+                        continue;
+
+                    // The silent band is faded out and becomes idle, the woken band is faded in after the warmup
+                    const float *vca    = NULL;
+                    const bool muted    = (b->bSilent) || (b->nWarmup > 0);
+                    b->nWarmup         -= lsp_min(b->nWarmup, samples);
+                    if (b->fMute != ((muted) ? 0.0f : 1.0f))
+                    {
+                        float k             = b->fMute;
+                        for (size_t n=0; n<samples; ++n)
+                        {
+                            k                   = (muted) ? lsp_max(k - fMuteStep, 0.0f) : lsp_min(k + fMuteStep, 1.0f);
+                            vBuffer[n]          = k;
+                        }
+                        b->fMute            = k;
+                        vca                 = vBuffer;
+                    }
+                    if ((b->bSilent) && (b->fMute <= 0.0f))
+                        bIdleSync           = true;
+
+                    // The band with -inf dB gain is processed only while its meters are visible, its mixing is skipped
+                    const bool audible  = (b->fGain > meta::beat_breather::BAND_GAIN_MIN) && ((vca != NULL) || (!muted));
+
+                    switch (b->nMixMode)
                     {
                         case BAND_BF:
-                            b->fOutLevel            = lsp_max(dsp::abs_max(b->vInData, samples) * b->fGain, b->fOutLevel);
+                            if (audible)
+                                level                   = ring_tail(&b->sRing, b->nOutDelay, c->vOutData, vca, b->fGain, mixed++ > 0, meters, samples);
                             b->fReduction           = b->fGain;
-                            if (mixed++)
-                                dsp::fmadd_k3(c->vOutData, b->vInData, b->fGain, samples);
-                            else
-                                dsp::mul_k3(c->vOutData, b->vInData, b->fGain, samples);
                             break;
                         case BAND_PD:
-                            b->fOutLevel            = lsp_max(dsp::abs_max(b->vPdData, samples) * b->fGain * pd_makeup, b->fOutLevel);
+                            if (b->nCtlRate > 1)
+                                b->fPdHold              = expand_control(b->vPdData, samples, nCtlPhase % b->nCtlRate, b->nCtlRate, b->fPdHold);
+                            if (audible)
+                                level                   = fused_apply(c->vOutData, b->vPdData, vca, b->fGain * pd_makeup, mixed++ > 0, meters, samples);
                             b->fReduction           = b->fPdLevel * b->fGain;
-                            if (mixed++)
-                                dsp::fmadd_k3(c->vOutData, b->vPdData, b->fGain * pd_makeup, samples);
-                            else
-                                dsp::mul_k3(c->vOutData, b->vPdData, b->fGain * pd_makeup, samples);
                             break;
                         case BAND_PF:
-                            b->fOutLevel            = lsp_max(dsp::abs_max(b->vPfData, samples) * b->fGain * pd_makeup, b->fOutLevel);
+                            if (b->nCtlRate > 1)
+                                b->fPfHold              = expand_control(b->vPfData, samples, nCtlPhase % b->nCtlRate, b->nCtlRate, b->fPfHold);
+                            if (audible)
+                                level                   = fused_apply(c->vOutData, b->vPfData, vca, b->fGain * pd_makeup, mixed++ > 0, meters, samples);
                             b->fReduction           = b->fPfReduction * b->fGain;
-                            if (mixed++)
-                                dsp::fmadd_k3(c->vOutData, b->vPfData, b->fGain * pd_makeup, samples);
-                            else
-                                dsp::mul_k3(c->vOutData, b->vPfData, b->fGain * pd_makeup, samples);
                             break;
                         case BAND_BP:
-                            b->fOutLevel            = lsp_max(dsp::abs_max(b->vBpData, samples) * b->fGain, b->fOutLevel);
+                            // The constant VCA is applied as a plain gain, the mute ramp is combined with the VCA
+                            if ((audible) && (vca != NULL) && (!b->bBpSteady))
+                                dsp::mul2(vBuffer, b->vBpData, samples);
+                            if (audible)
+                                level                   = (b->bBpSteady) ?
+                                    ring_tail(&b->sRing, b->nOutDelay, c->vOutData, vca, b->fGain * b->fBpSteady, mixed++ > 0, meters, samples) :
+                                    ring_tail(&b->sRing, b->nOutDelay, c->vOutData, (vca != NULL) ? vca : b->vBpData, b->fGain, mixed++ > 0, meters, samples);
                             b->fReduction           = b->fBpReduction * b->fGain;
-                            if (mixed++)
-                                dsp::fmadd_k3(c->vOutData, b->vBpData, b->fGain, samples);
-                            else
-                                dsp::mul_k3(c->vOutData, b->vBpData, b->fGain, samples);
                             break;
 
                         case BAND_MUTE:
@@ -1203,6 +3380,10 @@ namespace lsp
                         default:
                             break;
                     }
+
+                    // Update output level of the band
+                    if (meters)
+                        b->fOutLevel            = lsp_max(level, b->fOutLevel);
                 }
 
                 // Clear audio output if there is no one band active
@@ -1211,52 +3392,85 @@ namespace lsp
             }
         }
 
+        template <size_t CHANNELS>
         void beat_breather::post_process_block(size_t samples)
         {
-            // Apply delay compensation to input data and measure level
-            for (size_t i=0; i<nChannels; ++i)
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+
+            // Apply delay compensation to input data, mix and apply bypass switch
+            for (size_t i=0; i<CHANNELS; ++i)
             {
                 channel_t *c        = &vChannels[i];
 
-                // Delay the channel's input data
-                c->sDelay.process(c->vInData, c->vInData, samples);
-                // Measure the input level
-                c->fInLevel         = lsp_max(dsp::abs_max(c->vInData, samples), c->fInLevel);
+                // Delay the processed signal up to the locked latency, the ring is always fed to
+                // hold the recent output when the padding turns on
+                ring_push(&c->sPadRing, c->vOutData, samples);
+                if (c->nPadDelay > 0)
+                    ring_tail(&c->sPadRing, c->nPadDelay, c->vOutData, NULL, GAIN_AMP_0_DB, false, false, samples);
 
-                // Mix dry/wet into channel_t::vOutData
-                dsp::mix2(c->vOutData, c->vInData, fWetGain, fDryGain, samples);
+                // Read the delayed unprocessed signal, the gain is applied when mixing
+                const float level   = ring_tail(&c->sHistory, c->nDelay, c->vInData, NULL, GAIN_AMP_0_DB, false, meters, samples);
+                // Measure the input level
+                if (meters)
+                    c->fInLevel         = lsp_max(level * fInGain, c->fInLevel);
+                // Fill the gap in the output of the restarted engine with the delayed input
+                if (c->bRestart)
+                    crossfade_restart(c, samples);
+
+                // Mix dry/wet into channel_t::vOutData, the muted dry signal and the unity wet gain need no mixing
+                const float dry     = fDryGain * fInGain;
+                if (dry != GAIN_AMP_M_INF_DB)
+                {
+                    if (fWetGain != GAIN_AMP_0_DB)
+                        dsp::mix2(c->vOutData, c->vInData, fWetGain, dry, samples);
+                    else
+                        dsp::fmadd_k3(c->vOutData, c->vInData, dry, samples);
+                }
+                else if (fWetGain != GAIN_AMP_0_DB)
+                    dsp::mul_k2(c->vOutData, fWetGain, samples);
                 // Measure the output level
-                c->fOutLevel        = lsp_max(dsp::abs_max(c->vOutData, samples), c->fOutLevel);
+                if (meters)
+                    c->fOutLevel        = lsp_max(dsp::abs_max(c->vOutData, samples), c->fOutLevel);
+
+                // Apply bypass and output data
+                c->sBypass.process(c->vOut, c->vInData, c->vOutData, samples);
             }
 
             // Measure levels
             if (sAnalyzer.activity())
-                sAnalyzer.process(vAnalyze, samples);
-
-            // Apply bypass switch
-            for (size_t i=0; i<nChannels; ++i)
             {
-                channel_t *c        = &vChannels[i];
-
-                // Delay the dry signal
-                c->sDryDelay.process(vBuffer, c->vIn, samples);
-                // Apply bypass and output data
-                c->sBypass.process(c->vOut, vBuffer, c->vOutData, samples);
+                // The analyzer expects the input signal with the input gain applied
+                for (size_t i=0; i<CHANNELS; ++i)
+                {
+                    channel_t *c        = &vChannels[i];
+                    if (fInGain != GAIN_AMP_0_DB)
+                        dsp::mul_k2(c->vInData, fInGain, samples);
+                }
+                push_analyzer(samples);
             }
         }
 
+        template <size_t CHANNELS>
         void beat_breather::update_pointers(size_t samples)
         {
-            for (size_t i=0; i<nChannels; ++i)
+            for (size_t i=0; i<CHANNELS; ++i)
             {
                 channel_t *c        = &vChannels[i];
                 c->vIn             += samples;
                 c->vOut            += samples;
             }
+
+            nCtlPhase           = (nCtlPhase + samples) % meta::beat_breather::MULTIRATE_MAX;
         }
 
         void beat_breather::output_meters()
         {
+            // Output overload state, meshes are not updated under the meters degradation tier
+            const bool meters   = nOvlTier < meta::beat_breather::OVL_METERS;
+            pOvlTier->set_value(nOvlTier);
+            // Spectrum meshes are not updated while the analyzer worker is running or the analyzer awaits reconfiguration
+            const bool spectrum = (!analyzer_busy()) && (!bAnReconfig) && (!bAnFreqs);
+
             // Output meshes
             plug::mesh_t *mesh;
             for (size_t i=0; i<nChannels; ++i)
@@ -1264,7 +3478,7 @@ namespace lsp
                 channel_t *c        = &vChannels[i];
 
                 // Compute transfer curve
-                if (sCounter.fired())
+                if ((meters) && (sCounter.fired()))
                 {
                     for (size_t offset=0; offset<meta::beat_breather::FFT_MESH_POINTS; )
                     {
@@ -1275,7 +3489,7 @@ namespace lsp
                         for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
                         {
                             band_t *b       = &c->vBands[j];
-                            if ((b->nMode != BAND_OFF) && (b->nMode != BAND_MUTE))
+                            if (band_mixed(b->nMode))
                             {
                                 if (mixed++)
                                     dsp::fmadd_k3(
@@ -1307,7 +3521,7 @@ namespace lsp
                 c->pOutLevel->set_value(c->fOutLevel);
 
                 // Output transfer function of the channel
-                mesh        = (c->pFreqMesh != NULL) ? c->pFreqMesh->buffer<plug::mesh_t>() : NULL;
+                mesh        = ((meters) && (c->pFreqMesh != NULL)) ? c->pFreqMesh->buffer<plug::mesh_t>() : NULL;
                 if ((mesh != NULL) && (mesh->isEmpty()))
                 {
                     dsp::copy(mesh->pvData[0], vFftFreqs, meta::beat_breather::FFT_MESH_POINTS);
@@ -1329,6 +3543,8 @@ namespace lsp
                     b->pBpEnvLevel->set_value(b->fBpInGain);
                     b->pBpCurveLevel->set_value(b->fBpOutGain);
                     b->pBpGainLevel->set_value(b->fBpReduction);
+                    if (!meters)
+                        continue;
 
                     // Synchronize band transfer function mesh
                     if ((i == 0) && (b->nSync & SYNC_BAND_FILTER))
@@ -1350,7 +3566,7 @@ namespace lsp
                     }
 
                     // Synchronize peak detector mesh
-                    mesh            = b->pPdMesh->buffer<plug::mesh_t>();
+                    mesh            = (nTab == meta::beat_breather::TAB_PUNCH_DETECTOR) ? b->pPdMesh->buffer<plug::mesh_t>() : NULL;
                     if ((mesh != NULL) && (mesh->isEmpty()))
                     {
                         // Fill mesh with new values
@@ -1360,7 +3576,7 @@ namespace lsp
                     }
 
                     // Synchronize peak filter function mesh
-                    if ((i == 0) && (b->nSync & SYNC_PEAK_FILTER))
+                    if ((i == 0) && (nTab == meta::beat_breather::TAB_PUNCH_FILTER) && (b->nSync & SYNC_PEAK_FILTER))
                     {
                         mesh        = (b->pPfMesh != NULL) ? b->pPfMesh->buffer<plug::mesh_t>() : NULL;
                         if ((mesh != NULL) && (mesh->isEmpty()))
@@ -1374,13 +3590,13 @@ namespace lsp
                     }
 
                     // Synchronize beat processor function mesh
-                    if ((i == 0) && (b->nSync & SYNC_BEAT_PROC))
+                    if ((i == 0) && (nTab == meta::beat_breather::TAB_BEAT_PROCESSOR) && (b->nSync & SYNC_BEAT_PROC))
                     {
                         mesh        = (b->pBpMesh != NULL) ? b->pBpMesh->buffer<plug::mesh_t>() : NULL;
                         if ((mesh != NULL) && (mesh->isEmpty()))
                         {
                             dsp::copy(mesh->pvData[0], vBpMesh, meta::beat_breather::CURVE_MESH_POINTS);
-                            dsp::mul_k3(mesh->pvData[1], b->vBpMesh, b->fBpMakeup, meta::beat_breather::CURVE_MESH_POINTS);
+                            dsp::copy(mesh->pvData[1], b->vBpMesh, meta::beat_breather::CURVE_MESH_POINTS);
                             mesh->data(2, meta::beat_breather::CURVE_MESH_POINTS);
 
                             b->nSync        &= ~SYNC_BEAT_PROC;
@@ -1389,7 +3605,7 @@ namespace lsp
                 }
 
                 // Output spectrum analysis for input channel
-                mesh        = ((sAnalyzer.channel_active(c->nAnIn)) && (c->pInMesh != NULL)) ? c->pInMesh->buffer<plug::mesh_t>() : NULL;
+                mesh        = ((spectrum) && (sAnalyzer.channel_active(c->nAnIn)) && (c->pInMesh != NULL)) ? c->pInMesh->buffer<plug::mesh_t>() : NULL;
                 if ((mesh != NULL) && (mesh->isEmpty()))
                 {
                     // Add extra points
@@ -1406,7 +3622,7 @@ namespace lsp
                 }
 
                 // Output spectrum analysis for output channel
-                mesh        = ((sAnalyzer.channel_active(c->nAnOut)) && (c->pOutMesh != NULL)) ? c->pOutMesh->buffer<plug::mesh_t>() : NULL;
+                mesh        = ((spectrum) && (sAnalyzer.channel_active(c->nAnOut)) && (c->pOutMesh != NULL)) ? c->pOutMesh->buffer<plug::mesh_t>() : NULL;
                 if ((mesh != NULL) && (mesh->isEmpty()))
                 {
                     dsp::copy(mesh->pvData[0], vFftFreqs, meta::beat_breather::FFT_MESH_POINTS);
@@ -1431,6 +3647,16 @@ namespace lsp
                     b->nSync            = SYNC_ALL;
                 }
             }
+
+            // Bands with -inf dB gain should be processed for their meters
+            bUIActive       = true;
+            bIdleSync       = true;
+        }
+
+        void beat_breather::ui_deactivated()
+        {
+            bUIActive       = false;
+            bIdleSync       = true;
         }
 
         bool beat_breather::inline_display(plug::ICanvas *cv, size_t width, size_t height)
@@ -1529,6 +3755,66 @@ namespace lsp
             return true;
         }
 
+        void beat_breather::dump_gate_bank(dspu::IStateDumper *v, const char *name, const gate_bank_t *gb)
+        {
+            v->begin_object(name, gb, sizeof(gate_bank_t));
+            {
+                v->write("nGates", gb->nGates);
+                v->write("nLanes", gb->nLanes);
+                v->writev("vSlot", gb->vSlot, GATE_LANES_MAX);
+                v->writev("vIn", gb->vIn, GATE_LANES_MAX);
+                v->writev("vOut", gb->vOut, GATE_LANES_MAX);
+                v->writev("vEnv", gb->vEnv, GATE_LANES_MAX);
+                v->writev("vTauAttack", gb->vTauAttack, GATE_LANES_MAX);
+                v->writev("vTauRelease", gb->vTauRelease, GATE_LANES_MAX);
+                v->writev("vSlotEnv", gb->vSlotEnv, GATE_LANES_MAX);
+            }
+            v->end_object();
+        }
+
+        void beat_breather::dump_rms_bank(dspu::IStateDumper *v, const char *name, const rms_bank_t *rb)
+        {
+            v->begin_object(name, rb, sizeof(rms_bank_t));
+            {
+                v->write("nLanes", rb->nLanes);
+                v->write("nCapacity", rb->nCapacity);
+                v->write("nHead", rb->nHead);
+                v->write("vHistory", rb->vHistory);
+                v->writev("vIn", rb->vIn, RMS_LANES_MAX);
+                v->writev("vLongOut", rb->vLongOut, RMS_LANES_MAX);
+                v->writev("vShortOut", rb->vShortOut, RMS_LANES_MAX);
+                v->writev("vLong", rb->vLong, RMS_LANES_MAX);
+                v->writev("vShort", rb->vShort, RMS_LANES_MAX);
+                v->writev("vLongScale", rb->vLongScale, RMS_LANES_MAX);
+                v->writev("vShortScale", rb->vShortScale, RMS_LANES_MAX);
+                v->writev("vLongSum", rb->vLongSum, RMS_LANES_MAX);
+                v->writev("vShortSum", rb->vShortSum, RMS_LANES_MAX);
+                v->writev("vSeedHead", rb->vSeedHead, RMS_LANES_MAX);
+                v->writev("vSeedLeft", rb->vSeedLeft, RMS_LANES_MAX);
+                v->writev("vSeedSplit", rb->vSeedSplit, RMS_LANES_MAX);
+                v->writev("vSeedLength", rb->vSeedLength, RMS_LANES_MAX);
+                v->writev("vSeedNear", rb->vSeedNear, RMS_LANES_MAX);
+                v->writev("vSeedFar", rb->vSeedFar, RMS_LANES_MAX);
+            }
+            v->end_object();
+        }
+
+        void beat_breather::dump_ring(dspu::IStateDumper *v, const char *name, const ring_t *r)
+        {
+            v->begin_object(name, r, sizeof(ring_t));
+            {
+                v->write("vData", r->vData);
+                v->write("nCapacity", r->nCapacity);
+                v->write("nHead", r->nHead);
+                v->write("nRemapHead", r->nRemapHead);
+                v->write("nRemapLength", r->nRemapLength);
+                v->write("nRemapPushed", r->nRemapPushed);
+                v->write("nRemapFrom", r->nRemapFrom);
+                v->write("nRemapTo", r->nRemapTo);
+            }
+            v->end_object();
+        }
+
         void beat_breather::dump(dspu::IStateDumper *v) const
         {
             plug::Module::dump(v);
@@ -1542,8 +3828,13 @@ namespace lsp
 
                     v->write_object("sBypass", &c->sBypass);
                     v->write_object("sCrossover", &c->sCrossover);
-                    v->write_object("sDelay", &c->sDelay);
-                    v->write_object("sDryDelay", &c->sDryDelay);
+                    v->write_object("sSpectral", &c->sSpectral);
+                    v->write("nPadDelay", c->nPadDelay);
+                    v->write("bRestart", c->bRestart);
+                    v->write("nRestart", c->nRestart);
+                    v->write("nRestartHold", c->nRestartHold);
+                    dump_ring(v, "sHistory", &c->sHistory);
+                    dump_ring(v, "sPadRing", &c->sPadRing);
 
                     v->begin_array("vBands", c->vBands, meta::beat_breather::BANDS_MAX);
                     {
@@ -1551,20 +3842,32 @@ namespace lsp
                         {
                             const band_t *b     = &c->vBands[j];
 
-                            v->write_object("sDelay", &b->sDelay);
-                            v->write_object("sPdLong", &b->sPdLong);
-                            v->write_object("sPdShort", &b->sPdShort);
-                            v->write_object("sPdDelay", &b->sPdDelay);
+                            dump_ring(v, "sRing", &b->sRing);
+                            dump_ring(v, "sPdRing", &b->sPdRing);
                             v->write_object("sPdMeter", &b->sPdMeter);
                             v->write_object("sPf", &b->sPf);
-                            v->write_object("sPfDelay", &b->sPfDelay);
+                            dump_ring(v, "sPfRing", &b->sPfRing);
+                            v->write_object("sEarlyHpf", &b->sEarlyHpf);
+                            v->write_object("sEarlyLpf", &b->sEarlyLpf);
                             v->write_object("sBp", &b->sBp);
-                            v->write_object("sBpScDelay", &b->sBpScDelay);
-                            v->write_object("sBpDelay", &b->sBpDelay);
+                            dump_ring(v, "sBpScRing", &b->sBpScRing);
 
                             v->write("nOldMode", b->nOldMode);
+                            v->write("nMixMode", b->nMixMode);
                             v->write("nMode", b->nMode);
+                            v->write("nCompDelay", b->nCompDelay);
+                            v->write("nBpDelay", b->nBpDelay);
+                            v->write("nPfDelay", b->nPfDelay);
+                            v->write("nPdDelay", b->nPdDelay);
+                            v->write("nBpScDelay", b->nBpScDelay);
+                            v->write("nOutDelay", b->nOutDelay);
+                            v->write("nEarlyDelay", b->nEarlyDelay);
+                            v->write("nEarlyGd", b->nEarlyGd);
                             v->write("fGain", b->fGain);
+                            v->write("fMute", b->fMute);
+                            v->write("bSilent", b->bSilent);
+                            v->write("bIdle", b->bIdle);
+                            v->write("nWarmup", b->nWarmup);
                             v->write("fInLevel", b->fInLevel);
                             v->write("fOutLevel", b->fOutLevel);
                             v->write("fReduction", b->fReduction);
@@ -1578,6 +3881,25 @@ namespace lsp
                             v->write("fBpInGain", b->fBpInGain);
                             v->write("fBpOutGain", b->fBpOutGain);
                             v->write("fBpReduction", b->fBpReduction);
+                            v->write("fPdHold", b->fPdHold);
+                            v->write("fPfHold", b->fPfHold);
+                            v->write("fBpHold", b->fBpHold);
+                            v->write("bBpSteady", b->bBpSteady);
+                            v->write("fBpSteady", b->fBpSteady);
+                            v->write("nCtlRate", b->nCtlRate);
+                            v->write("nCtlGroup", b->nCtlGroup);
+                            v->write("fCtlTop", b->fCtlTop);
+                            v->write("fSpcLong", b->fSpcLong);
+                            v->write("fSpcShort", b->fSpcShort);
+                            v->write("fSpcPfEnv", b->fSpcPfEnv);
+                            v->write("fSpcBpEnv", b->fSpcBpEnv);
+                            v->write("fSpcLongTau", b->fSpcLongTau);
+                            v->write("fSpcShortTau", b->fSpcShortTau);
+                            v->write("fSpcPfAttack", b->fSpcPfAttack);
+                            v->write("fSpcPfRelease", b->fSpcPfRelease);
+                            v->write("fSpcBpAttack", b->fSpcBpAttack);
+                            v->write("fSpcBpRelease", b->fSpcBpRelease);
+                            v->write("fSpcBias", b->fSpcBias);
 
                             v->write("vInData", b->vInData);
                             v->write("vPdData", b->vPdData);
@@ -1631,6 +3953,8 @@ namespace lsp
                     }
                     v->end_array();
 
+                    v->write("nPhaseSlot", c->nPhaseSlot);
+                    v->write("nDelay", c->nDelay);
                     v->write("nAnIn", c->nAnIn);
                     v->write("nAnOut", c->nAnOut);
                     v->write("fInLevel", c->fInLevel);
@@ -1661,9 +3985,60 @@ namespace lsp
             v->write("fDryGain", fDryGain);
             v->write("fWetGain", fWetGain);
             v->write("fZoom", fZoom);
+            v->write("fMuteStep", fMuteStep);
+            v->write("fRestartStep", fRestartStep);
+            v->write("nTab", nTab);
+            v->write("nFftRank", nFftRank);
+            v->write("nXoverRank", nXoverRank);
+            v->write("nMaxBandLatency", nMaxBandLatency);
+            v->write("nLockLatency", nLockLatency);
+            v->write("nCtlRate", nCtlRate);
+            v->write("nCtlPhase", nCtlPhase);
+            v->write("bOvlGuard", bOvlGuard);
+            v->write("nOvlTier", nOvlTier);
+            v->write("nOvlHigh", nOvlHigh);
+            v->write("nOvlLow", nOvlLow);
+            v->write("nOvlBackoff", nOvlBackoff);
+            v->write("bIdleSync", bIdleSync);
+            v->write("bUIActive", bUIActive);
+            v->write("fOvlLoad", fOvlLoad);
             v->writev("vAnalyze", vAnalyze, 4);
+            v->writev("vAnRing", vAnRing, 4);
+            v->writev("vAnData", vAnData, 4);
+            v->write("nAnHead", nAnHead);
+            v->write("nAnTail", nAnTail);
+            v->write("bAnSync", bAnSync);
+            v->write("bAnReconfig", bAnReconfig);
+            v->write("bAnFreqs", bAnFreqs);
+            v->writev("vAnFir", vAnFir, HALFBAND_ODD);
+            v->write("nAnDecimation", nAnDecimation);
+            v->write("nAnStages", nAnStages);
+            v->write("bMultirate", bMultirate);
+            v->write("bSpectral", bSpectral);
+            v->write("bEarly", bEarly);
+            v->write("bLatencyLock", bLatencyLock);
+            v->write("nEngine", nEngine);
+            v->write("bSpcSync", bSpcSync);
+            v->write("nSpcBins", nSpcBins);
+            v->write("vSpcMask", vSpcMask);
+            v->write("vSpcGain", vSpcGain);
+            v->write("vSpcPower", vSpcPower);
+            v->begin_array("vPfBanks", vPfBanks, CTL_GROUPS);
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+                dump_gate_bank(v, NULL, &vPfBanks[i]);
+            v->end_array();
+            v->begin_array("vBpBanks", vBpBanks, CTL_GROUPS);
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+                dump_gate_bank(v, NULL, &vBpBanks[i]);
+            v->end_array();
+            v->begin_array("vRmsBanks", vRmsBanks, CTL_GROUPS);
+            for (size_t i=0; i<CTL_GROUPS; ++i)
+                dump_rms_bank(v, NULL, &vRmsBanks[i]);
+            v->end_array();
 
             v->write_object("sAnalyzer", &sAnalyzer);
+            v->write("sAnTask", &sAnTask);
+            v->write("pExecutor", pExecutor);
             v->write_object("sCounter", &sCounter);
 
             v->begin_array("vSplits", vSplits, meta::beat_breather::BANDS_MAX-1);
@@ -1687,6 +4062,8 @@ namespace lsp
             v->write("vBuffer", vBuffer);
             v->write("vFftFreqs", vFftFreqs);
             v->write("vFftIndexes", vFftIndexes);
+            v->write("vAnFreqs", vAnFreqs);
+            v->write("vAnIndexes", vAnIndexes);
             v->write("vPdMesh", vPdMesh);
             v->write("vPfMesh", vPfMesh);
             v->write("vBpMesh", vBpMesh);
@@ -1697,12 +4074,22 @@ namespace lsp
             v->write("pWetGain", pWetGain);
             v->write("pDryWet", pDryWet);
             v->write("pOutGain", pOutGain);
+            v->write("pTabSel", pTabSel);
             v->write("pStereoSplit", pStereoSplit);
             v->write("pFFTReactivity", pFFTReactivity);
             v->write("pFFTShift", pFFTShift);
             v->write("pZoom", pZoom);
             v->write("pIDisplay", pIDisplay);
+            v->write("pOvlGuard", pOvlGuard);
+            v->write("pOvlTier", pOvlTier);
+            v->write("pXoverQuality", pXoverQuality);
+            v->write("pMultirate", pMultirate);
+            v->write("pSpectral", pSpectral);
+            v->write("pEarly", pEarly);
+            v->write("pLatencyLock", pLatencyLock);
             v->write("pData", pData);
+            v->write("pRmsData", pRmsData);
+            v->write("pSpcData", pSpcData);
         }
 
     } /* namespace plugins */
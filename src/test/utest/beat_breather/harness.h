@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-beat-breather
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-beat-breather is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-beat-breather is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-beat-breather. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_UTEST_BEAT_BREATHER_HARNESS_H_
+#define TEST_UTEST_BEAT_BREATHER_HARNESS_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/ITask.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+
+#include <private/plugins/beat_breather.h>
+
+#include <string.h>
+
+namespace lsp
+{
+    namespace test
+    {
+        namespace beat_breather
+        {
+            /**
+             * Port which keeps the value or the buffer assigned by the harness
+             */
+            class Port: public plug::IPort
+            {
+                private:
+                    float               fValue;
+                    void               *pBuffer;
+
+                public:
+                    explicit Port(const meta::port_t *meta): plug::IPort(meta)
+                    {
+                        fValue      = meta->start;
+                        pBuffer     = NULL;
+                    }
+
+                public:
+                    virtual float value() override              { return fValue;            }
+                    virtual void set_value(float value) override { fValue = value;          }
+                    virtual void *buffer() override             { return pBuffer;           }
+
+                public:
+                    inline void set_buffer(void *buffer)        { pBuffer = buffer;         }
+            };
+
+            /**
+             * Executor which keeps the submitted task until the test runs it explicitly,
+             * outside of the code under test
+             */
+            class Executor: public ipc::IExecutor
+            {
+                private:
+                    ipc::ITask         *pTask;
+
+                public:
+                    Executor()
+                    {
+                        pTask       = NULL;
+                    }
+
+                public:
+                    virtual bool submit(ipc::ITask *task) override
+                    {
+                        if (pTask != NULL)
+                            return false;
+                        change_task_state(task, ipc::ITask::TS_SUBMITTED);
+                        pTask       = task;
+                        return true;
+                    }
+
+                    virtual void shutdown() override
+                    {
+                        run_pending();
+                    }
+
+                public:
+                    void run_pending()
+                    {
+                        ipc::ITask *task    = pTask;
+                        if (task == NULL)
+                            return;
+                        pTask       = NULL;
+                        run_task(task);
+                    }
+            };
+
+            /**
+             * Minimal wrapper providing the executor to the plugin
+             */
+            class Wrapper: public plug::IWrapper
+            {
+                private:
+                    ipc::IExecutor     *pExecutor;
+
+                public:
+                    explicit Wrapper(plug::Module *plugin, ipc::IExecutor *executor): plug::IWrapper(plugin, NULL)
+                    {
+                        pExecutor   = executor;
+                    }
+
+                public:
+                    virtual ipc::IExecutor *executor() override { return pExecutor;     }
+            };
+
+            /**
+             * Host of the plugin instance: creates ports from the metadata, assigns audio buffers
+             * and forwards the calls the host would do
+             */
+            class Harness
+            {
+                private:
+                    plug::Module       *pPlugin;
+                    const meta::plugin_t   *pMeta;
+                    Executor            sExecutor;
+                    Wrapper             sWrapper;
+                    plug::IPort       **vPorts;
+                    size_t              nPorts;
+                    float              *vBuffers;
+                    size_t              nBlock;
+                    bool                bInit;
+
+                public:
+                    explicit Harness(plug::Module *plugin, const meta::plugin_t *meta, size_t block):
+                        sWrapper(plugin, &sExecutor)
+                    {
+                        pPlugin     = plugin;
+                        pMeta       = meta;
+                        vPorts      = NULL;
+                        nPorts      = 0;
+                        vBuffers    = NULL;
+                        nBlock      = block;
+                        bInit       = false;
+                    }
+
+                    ~Harness()
+                    {
+                        if (bInit)
+                        {
+                            sExecutor.run_pending();
+                            pPlugin->destroy();
+                        }
+                        delete pPlugin;
+
+                        for (size_t i=0; i<nPorts; ++i)
+                            delete vPorts[i];
+                        delete [] vPorts;
+                        delete [] vBuffers;
+                    }
+
+                public:
+                    bool init()
+                    {
+                        size_t audio    = 0;
+                        for (const meta::port_t *p = pMeta->ports; p->id != NULL; ++p, ++nPorts)
+                        {
+                            if ((p->role == meta::R_AUDIO_IN) || (p->role == meta::R_AUDIO_OUT))
+                                ++audio;
+                        }
+
+                        vPorts          = new plug::IPort *[nPorts];
+                        vBuffers        = new float[audio * nBlock];
+                        memset(vBuffers, 0, sizeof(float) * audio * nBlock);
+
+                        float *buf      = vBuffers;
+                        for (size_t i=0; i<nPorts; ++i)
+                        {
+                            const meta::port_t *p   = &pMeta->ports[i];
+                            Port *port      = new Port(p);
+                            vPorts[i]       = port;
+                            if ((p->role == meta::R_AUDIO_IN) || (p->role == meta::R_AUDIO_OUT))
+                            {
+                                port->set_buffer(buf);
+                                buf            += nBlock;
+                            }
+                        }
+
+                        pPlugin->init(&sWrapper, vPorts);
+                        bInit           = true;
+                        return true;
+                    }
+
+                    inline size_t block() const                 { return nBlock;            }
+                    inline size_t ports() const                 { return nPorts;            }
+                    inline Port *port(size_t index)             { return (index < nPorts) ? static_cast<Port *>(vPorts[index]) : NULL; }
+
+                    Port *port(const char *id)
+                    {
+                        for (size_t i=0; i<nPorts; ++i)
+                            if (!strcmp(vPorts[i]->metadata()->id, id))
+                                return static_cast<Port *>(vPorts[i]);
+                        return NULL;
+                    }
+
+                    bool set(const char *id, float value)
+                    {
+                        Port *p         = port(id);
+                        if (p == NULL)
+                            return false;
+                        p->set_value(value);
+                        return true;
+                    }
+
+                    float *audio(const char *id)
+                    {
+                        Port *p         = port(id);
+                        return (p != NULL) ? static_cast<float *>(p->buffer()) : NULL;
+                    }
+
+                    inline void set_sample_rate(long sr)        { pPlugin->set_sample_rate(sr); }
+                    inline void update_settings()               { pPlugin->update_settings();   }
+                    inline void process(size_t samples)         { pPlugin->process(samples);    }
+                    inline void run_tasks()                     { sExecutor.run_pending();      }
+            };
+
+        } /* namespace beat_breather */
+    } /* namespace test */
+} /* namespace lsp */
+
+#endif /* TEST_UTEST_BEAT_BREATHER_HARNESS_H_ */
@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-beat-breather
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-beat-breather is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-beat-breather is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-beat-breather. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+
+// The test interposes functions of the GNU C library, other platforms are not supported
+#if defined(PLATFORM_LINUX) && defined(__GLIBC__)
+
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include "harness.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace
+{
+    /**
+     * Real-time guard of the audio thread: while it is active, each call of a function
+     * which may allocate memory, block or enter the kernel is counted as a violation
+     */
+    static __thread bool        rt_active       = false;
+    static __thread size_t      rt_violations   = 0;
+    static __thread const char *rt_first        = NULL;
+
+    static inline void rt_check(const char *func)
+    {
+        if (!rt_active)
+            return;
+        if ((rt_violations++) == 0)
+            rt_first        = func;
+    }
+
+    static void rt_enter()
+    {
+        rt_violations   = 0;
+        rt_first        = NULL;
+        rt_active       = true;
+    }
+
+    static size_t rt_leave()
+    {
+        rt_active       = false;
+        return rt_violations;
+    }
+
+    template <class T>
+    static T rt_real(T *fn, const char *name)
+    {
+        if (*fn == NULL)
+            *fn             = reinterpret_cast<T>(dlsym(RTLD_NEXT, name));
+        return *fn;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Interposed functions, the memory allocator is accessed directly to avoid recursion
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t n, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void *__libc_memalign(size_t align, size_t size);
+    void __libc_free(void *ptr);
+
+    void *malloc(size_t size) __THROW
+    {
+        rt_check("malloc");
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t n, size_t size) __THROW
+    {
+        rt_check("calloc");
+        return __libc_calloc(n, size);
+    }
+
+    void *realloc(void *ptr, size_t size) __THROW
+    {
+        rt_check("realloc");
+        return __libc_realloc(ptr, size);
+    }
+
+    void free(void *ptr) __THROW
+    {
+        if (ptr != NULL)
+            rt_check("free");
+        __libc_free(ptr);
+    }
+
+    void *memalign(size_t align, size_t size) __THROW
+    {
+        rt_check("memalign");
+        return __libc_memalign(align, size);
+    }
+
+    void *aligned_alloc(size_t align, size_t size) __THROW
+    {
+        rt_check("aligned_alloc");
+        return __libc_memalign(align, size);
+    }
+
+    int posix_memalign(void **ptr, size_t align, size_t size) __THROW
+    {
+        rt_check("posix_memalign");
+        if ((align < sizeof(void *)) || (align & (align - 1)))
+            return EINVAL;
+        void *res       = __libc_memalign(align, size);
+        if (res == NULL)
+            return ENOMEM;
+        *ptr            = res;
+        return 0;
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t *mutex) __THROW
+    {
+        static int (*real)(pthread_mutex_t *) = NULL;
+        rt_check("pthread_mutex_lock");
+        return rt_real(&real, "pthread_mutex_lock")(mutex);
+    }
+
+    int pthread_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex)
+    {
+        static int (*real)(pthread_cond_t *, pthread_mutex_t *) = NULL;
+        rt_check("pthread_cond_wait");
+        return rt_real(&real, "pthread_cond_wait")(cond, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex, const struct timespec *abstime)
+    {
+        static int (*real)(pthread_cond_t *, pthread_mutex_t *, const struct timespec *) = NULL;
+        rt_check("pthread_cond_timedwait");
+        return rt_real(&real, "pthread_cond_timedwait")(cond, mutex, abstime);
+    }
+
+    int sem_wait(sem_t *sem)
+    {
+        static int (*real)(sem_t *) = NULL;
+        rt_check("sem_wait");
+        return rt_real(&real, "sem_wait")(sem);
+    }
+
+    int nanosleep(const struct timespec *req, struct timespec *rem)
+    {
+        static int (*real)(const struct timespec *, struct timespec *) = NULL;
+        rt_check("nanosleep");
+        return rt_real(&real, "nanosleep")(req, rem);
+    }
+
+    int usleep(useconds_t usec)
+    {
+        static int (*real)(useconds_t) = NULL;
+        rt_check("usleep");
+        return rt_real(&real, "usleep")(usec);
+    }
+
+    int sched_yield() __THROW
+    {
+        static int (*real)() = NULL;
+        rt_check("sched_yield");
+        return rt_real(&real, "sched_yield")();
+    }
+
+    ssize_t write(int fd, const void *buf, size_t count)
+    {
+        static ssize_t (*real)(int, const void *, size_t) = NULL;
+        rt_check("write");
+        return rt_real(&real, "write")(fd, buf, count);
+    }
+
+    ssize_t read(int fd, void *buf, size_t count)
+    {
+        static ssize_t (*real)(int, void *, size_t) = NULL;
+        rt_check("read");
+        return rt_real(&real, "read")(fd, buf, count);
+    }
+}
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr size_t BLOCK_SIZE              = 512;
+    static constexpr size_t SWEEP_ITERATIONS        = 48;
+    static constexpr size_t SWEEP_BLOCKS            = 6;
+    static constexpr double BUDGET_FACTOR           = 8.0;      // Allowed CPU time relative to the duration of the block
+    static constexpr double BUDGET_MIN              = 2e-3;     // Minimum allowed CPU time of the block, seconds
+
+    static const long sample_rates[] = { 44100, 96000, 192000, 48000, 22050 };
+
+    /**
+     * Linear congruential generator, the test should not depend on the implementation of rand()
+     */
+    typedef struct lcg_t
+    {
+        uint32_t    nState;
+
+        inline uint32_t next()
+        {
+            nState      = nState * 1664525u + 1013904223u;
+            return nState;
+        }
+
+        inline float uniform()
+        {
+            return float(next() >> 8) / float(1 << 24);
+        }
+    } lcg_t;
+
+    /**
+     * CPU time consumed by the calling thread, preemption of the thread does not affect it
+     */
+    static double thread_time()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return double(ts.tv_sec) + double(ts.tv_nsec) * 1e-9;
+    }
+}
+
+UTEST_BEGIN("beat_breather", rt_safety)
+
+    void randomize_port(test::beat_breather::Port *port, lcg_t *rnd)
+    {
+        const meta::port_t *p   = port->metadata();
+        float min = 0.0f, max = 1.0f, step = 0.0f;
+        meta::get_port_parameters(p, &min, &max, &step);
+
+        float value             = min + (max - min) * rnd->uniform();
+        if ((p->flags & meta::F_INT) || (p->unit == meta::U_BOOL) || (p->unit == meta::U_ENUM))
+            value                   = truncf(value + 0.5f);
+        port->set_value(lsp_limit(value, lsp_min(min, max), lsp_max(min, max)));
+    }
+
+    void fill_inputs(test::beat_breather::Harness *h, lcg_t *rnd, size_t samples)
+    {
+        for (size_t i=0; i<h->ports(); ++i)
+        {
+            test::beat_breather::Port *port = h->port(i);
+            if (port->metadata()->role != meta::R_AUDIO_IN)
+                continue;
+
+            // Noise with random transients keeps the punch detectors and gates busy
+            float *buf              = static_cast<float *>(port->buffer());
+            const float level       = (rnd->uniform() < 0.25f) ? 1.0f : 0.1f;
+            for (size_t j=0; j<samples; ++j)
+                buf[j]                  = (rnd->uniform() * 2.0f - 1.0f) * level;
+        }
+    }
+
+    void check_guard()
+    {
+        // Ensure that the interposed functions are really called
+        rt_enter();
+        void * volatile ptr     = malloc(16);
+        free(ptr);
+        const size_t violations = rt_leave();
+        UTEST_ASSERT_MSG(violations == 2, "Interposition of memory allocator does not work: violations=%d", int(violations));
+    }
+
+    void check_plugin(const meta::plugin_t *meta, uint32_t seed)
+    {
+        test::beat_breather::Harness h(new plugins::beat_breather(meta), meta, BLOCK_SIZE);
+        UTEST_ASSERT(h.init());
+
+        lcg_t rnd;
+        rnd.nState              = seed;
+
+        for (size_t i=0; i<sizeof(sample_rates)/sizeof(long); ++i)
+        {
+            // Sample rate is applied by the host outside of the audio thread
+            h.run_tasks();
+            h.set_sample_rate(sample_rates[i]);
+
+            for (size_t j=0; j<SWEEP_ITERATIONS; ++j)
+            {
+                // Change a random subset of parameters, each few iterations change all of them
+                const float density     = ((j % 8) == 0) ? 1.0f : 0.25f;
+                for (size_t k=0; k<h.ports(); ++k)
+                {
+                    test::beat_breather::Port *port = h.port(k);
+                    const meta::role_t role = port->metadata()->role;
+                    if ((role != meta::R_CONTROL) && (role != meta::R_BYPASS))
+                        continue;
+                    if (rnd.uniform() < density)
+                        randomize_port(port, &rnd);
+                }
+
+                // Settings update and processing are performed by the audio thread. Each block, including the
+                // settings update before the first one, should fit the budget of the host period of BLOCK_SIZE
+                // samples, so heavy work like the replay of the history on the audio thread fails the test
+                const double budget     = lsp_max(BUDGET_FACTOR * double(BLOCK_SIZE) / double(sample_rates[i]), BUDGET_MIN);
+                double max_time         = 0.0;
+                size_t max_block        = 0;
+
+                rt_enter();
+                double start            = thread_time();
+                h.update_settings();
+                for (size_t k=0; k<SWEEP_BLOCKS; ++k)
+                {
+                    const size_t samples    = (k & 1) ? BLOCK_SIZE : 1 + (rnd.next() % BLOCK_SIZE);
+                    rt_active               = false;
+                    const double pause      = thread_time();
+                    fill_inputs(&h, &rnd, samples);
+                    start                  += thread_time() - pause;
+                    rt_active               = true;
+                    h.process(samples);
+
+                    const double end        = thread_time();
+                    if ((end - start) > max_time)
+                    {
+                        max_time                = end - start;
+                        max_block               = k;
+                    }
+                    start                   = end;
+                }
+                const char *func        = rt_first;
+                const size_t violations = rt_leave();
+
+                UTEST_ASSERT_MSG(violations == 0,
+                    "Real-time violation in plugin=%s, sample_rate=%ld, iteration=%d: %d calls, first call: %s()",
+                    meta->uid, sample_rates[i], int(j), int(violations), func);
+                UTEST_ASSERT_MSG(max_time <= budget,
+                    "Time budget exceeded in plugin=%s, sample_rate=%ld, iteration=%d, block=%d: %.3f ms of %.3f ms",
+                    meta->uid, sample_rates[i], int(j), int(max_block), max_time * 1e3, budget * 1e3);
+
+                // The analyzer worker runs outside of the audio thread
+                h.run_tasks();
+            }
+
+            printf("  plugin=%s, sample_rate=%ld: %d iterations passed\n",
+                meta->uid, sample_rates[i], int(SWEEP_ITERATIONS));
+        }
+    }
+
+    UTEST_MAIN
+    {
+        dsp::init();
+
+        check_guard();
+        check_plugin(&meta::beat_breather_mono, 0x1234567u);
+        check_plugin(&meta::beat_breather_stereo, 0x89abcdeu);
+    }
+
+UTEST_END
+
+#endif /* PLATFORM_LINUX && __GLIBC__ */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-beat-breather
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins-beat-breather is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-beat-breather is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-beat-breather. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+#include "harness.h"
+
+#include <math.h>
+#include <stdio.h>
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr float MASK_TOLERANCE           = 1e-2f;
+
+    /**
+     * Exposes the band masks of the spectral gain mode
+     */
+    class MaskProbe: public plugins::beat_breather
+    {
+        public:
+            explicit MaskProbe(const meta::plugin_t *meta): plugins::beat_breather(meta) {}
+
+        public:
+            bool spectral() const
+            {
+                return nEngine != ENGINE_CROSSOVER;
+            }
+
+            size_t bins()
+            {
+                return (size_t(1) << (vChannels[0].sSpectral.get_rank() - 1)) + 1;
+            }
+
+            const float *mask(size_t band) const
+            {
+                return (vChannels[0].vBands[band].nMode != BAND_OFF) ? &vSpcMask[band * nSpcBins] : NULL;
+            }
+    };
+
+    typedef struct split_config_t
+    {
+        const char     *name;
+        float           enabled[meta::beat_breather::BANDS_MAX - 1];
+    } split_config_t;
+
+    static const split_config_t split_configs[] =
+    {
+        { "default",    { 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f } },
+        { "single",     { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f } },
+        { "all",        { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f } },
+        { "none",       { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } },
+    };
+
+    static const long sample_rates[] = { 44100, 48000, 96000, 192000 };
+}
+
+UTEST_BEGIN("beat_breather", spectral_masks)
+
+    void check_masks(const split_config_t *cfg, long sample_rate, float listen)
+    {
+        MaskProbe *probe = new MaskProbe(&meta::beat_breather_mono);
+        test::beat_breather::Harness h(probe, &meta::beat_breather_mono, 512);
+        UTEST_ASSERT(h.init());
+        h.set_sample_rate(sample_rate);
+
+        char id[32];
+        h.set("spec", 1.0f);
+        for (size_t i=0; i<meta::beat_breather::BANDS_MAX - 1; ++i)
+        {
+            snprintf(id, sizeof(id), "se_%d", int(i + 1));
+            UTEST_ASSERT(h.set(id, cfg->enabled[i]));
+        }
+        for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+        {
+            snprintf(id, sizeof(id), "bls_%d", int(j + 1));
+            UTEST_ASSERT(h.set(id, listen));
+        }
+        h.update_settings();
+        UTEST_ASSERT(probe->spectral());
+
+        // The sum of magnitude responses of all active bands should be flat
+        const size_t bins   = probe->bins();
+        float worst         = 0.0f;
+        size_t worst_bin    = 0;
+        for (size_t k=0; k<bins; ++k)
+        {
+            float sum           = 0.0f;
+            for (size_t j=0; j<meta::beat_breather::BANDS_MAX; ++j)
+            {
+                const float *mask   = probe->mask(j);
+                if (mask != NULL)
+                    sum                += mask[k];
+            }
+
+            const float error   = fabsf(sum - 1.0f);
+            if (error > worst)
+            {
+                worst               = error;
+                worst_bin           = k;
+            }
+        }
+
+        printf("  splits=%s, sample_rate=%ld, listen=%d: bins=%d, max error=%g at bin %d\n",
+            cfg->name, sample_rate, int(listen), int(bins), worst, int(worst_bin));
+        UTEST_ASSERT_MSG(worst <= MASK_TOLERANCE,
+            "Sum of band masks is not flat: error=%g at bin %d (splits=%s, sample_rate=%ld)",
+            worst, int(worst_bin), cfg->name, sample_rate);
+    }
+
+    UTEST_MAIN
+    {
+        dsp::init();
+
+        for (size_t i=0; i<sizeof(split_configs)/sizeof(split_config_t); ++i)
+            for (size_t j=0; j<sizeof(sample_rates)/sizeof(long); ++j)
+            {
+                // Band filter only (static engine) and beat processor (spectral engine)
+                check_masks(&split_configs[i], sample_rates[j], meta::beat_breather::LISTEN_CROSSOVER);
+                check_masks(&split_configs[i], sample_rates[j], meta::beat_breather::LISTEN_BEAT);
+            }
+    }
+
+UTEST_END